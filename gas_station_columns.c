@@ -0,0 +1,90 @@
+#ifdef __linux__
+// "Let's go!"
+#else
+#error "Only __linux__ supported"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#include "util_columnar.h"
+
+typedef struct
+{
+    uint64_t vehicles;
+    uint64_t outcomes[VEHICLE_OUTCOMES_COUNT];
+    int64_t fuel_required;
+    int64_t fuel_received;
+    uint64_t wait_ns;
+    uint64_t max_wait_ns;
+} TypeSummary;
+
+// Group-by-type summary straight from the mapped columns; the pump id column is never touched
+int main(int argc, char **argv)
+{
+    if (argc != 2)
+    {
+        printf("Usage: %s <results.gscol>\n", argv[0]);
+        return 1;
+    }
+
+    ColumnarFile *file = columnar_file_open(argv[1]);
+    if (file == NULL)
+    {
+        return 1;
+    }
+
+    uint64_t rows_count = file->header->rows_count;
+    const uint8_t *vehicle_types = (const uint8_t *)columnar_file_get_column(file, COLUMN_VEHICLE_TYPE);
+    const uint8_t *outcomes = (const uint8_t *)columnar_file_get_column(file, COLUMN_OUTCOME);
+    const int32_t *fuel_required = (const int32_t *)columnar_file_get_column(file, COLUMN_FUEL_REQUIRED);
+    const int32_t *fuel_received = (const int32_t *)columnar_file_get_column(file, COLUMN_FUEL_RECEIVED);
+    const uint64_t *wait_ns = (const uint64_t *)columnar_file_get_column(file, COLUMN_WAIT_NS);
+
+    // Last slot collects rows with an unknown vehicle type
+    TypeSummary summaries[VEHICLE_NOT_FOUND + 1];
+    memset(summaries, 0, sizeof(summaries));
+    for (uint64_t i = 0; i < rows_count; i++)
+    {
+        int vehicle_type = vehicle_types[i] < VEHICLE_NOT_FOUND ? vehicle_types[i] : VEHICLE_NOT_FOUND;
+        TypeSummary *summary = &summaries[vehicle_type];
+        summary->vehicles++;
+        if (outcomes[i] < VEHICLE_OUTCOMES_COUNT)
+        {
+            summary->outcomes[outcomes[i]]++;
+        }
+        summary->fuel_required += fuel_required[i];
+        summary->fuel_received += fuel_received[i];
+        summary->wait_ns += wait_ns[i];
+        if (wait_ns[i] > summary->max_wait_ns)
+        {
+            summary->max_wait_ns = wait_ns[i];
+        }
+    }
+
+    printf("vehicle_type,vehicles,refueled,timeout,no_fuel,fuel_required,fuel_received,average_wait_sec,max_wait_sec\n");
+    for (int i = 0; i <= VEHICLE_NOT_FOUND; i++)
+    {
+        const TypeSummary *summary = &summaries[i];
+        if (summary->vehicles == 0 && i == VEHICLE_NOT_FOUND)
+        {
+            continue;
+        }
+        printf("%s,%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRId64 ",%" PRId64 ",%.6f,%.6f\n",
+               get_vehicle_type_name((VehicleType)i),
+               summary->vehicles,
+               summary->outcomes[VEHICLE_OUTCOME_REFUELED],
+               summary->outcomes[VEHICLE_OUTCOME_TIMEOUT],
+               summary->outcomes[VEHICLE_OUTCOME_NO_FUEL],
+               summary->fuel_required,
+               summary->fuel_received,
+               summary->vehicles > 0 ? summary->wait_ns / 1e9 / summary->vehicles : 0,
+               summary->max_wait_ns / 1e9);
+    }
+
+    columnar_file_close(&file);
+    return 0;
+}
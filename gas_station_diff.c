@@ -0,0 +1,677 @@
+#ifdef __linux__
+// "Let's go!"
+#else
+#error "Only __linux__ supported"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "util_json_tokenizer.h"
+#include "util_columnar.h"
+#include "util_histogram.h"
+
+#define INITIAL_METRICS_CAPACITY 256
+#define METRIC_NAME_LENGTH 96
+#define MAX_ELEMENT_METRICS 32
+#define SIGNIFICANCE_LEVEL 0.05
+
+typedef struct
+{
+    char name[METRIC_NAME_LENGTH];
+    double value;
+} Metric;
+
+// Every numeric value of one run, keyed by a flat name such as "vehicles_stats.wait_time_p95_sec",
+// "auto.total_serviced_cars" or "pump_2.utilization_percent". Both input formats use the same names.
+// Metrics keep their insertion order in [metrics]; [slots] is an open addressing index into it
+// (-1 for free slots), at most half full. Both grow with the run, one metric set per pump included.
+typedef struct
+{
+    Metric *metrics;
+    int count;
+    int capacity;
+    int *slots;
+    int slots_capacity;
+    _Bool has_error;
+} RunSummary;
+
+static uint32_t get_name_hash(const char *name)
+{
+    uint32_t hash = 2166136261u;
+    for (const unsigned char *cursor = (const unsigned char *)name; *cursor != '\0'; cursor++)
+    {
+        hash = (hash ^ *cursor) * 16777619u;
+    }
+    return hash;
+}
+
+// Slot holding [name], or the free slot where it belongs
+static int find_slot(const RunSummary *summary, const char *name)
+{
+    int mask = summary->slots_capacity - 1;
+    int slot = (int)(get_name_hash(name) & (uint32_t)mask);
+    while (summary->slots[slot] != -1 && strcmp(summary->metrics[summary->slots[slot]].name, name) != 0)
+    {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+static int grow_summary(RunSummary *summary)
+{
+    // Both arrays are allocated before [summary] changes, so a failure leaves it consistent
+    int capacity = summary->capacity == 0 ? INITIAL_METRICS_CAPACITY : summary->capacity * 2;
+    int *slots = (int *)malloc(2 * capacity * sizeof(int));
+    if (slots == NULL)
+    {
+        return 0;
+    }
+    Metric *metrics = (Metric *)realloc(summary->metrics, capacity * sizeof(Metric));
+    if (metrics == NULL)
+    {
+        free(slots);
+        return 0;
+    }
+    summary->metrics = metrics;
+    summary->capacity = capacity;
+    free(summary->slots);
+    summary->slots = slots;
+    summary->slots_capacity = 2 * capacity;
+    memset(summary->slots, -1, summary->slots_capacity * sizeof(int));
+    for (int i = 0; i < summary->count; i++)
+    {
+        summary->slots[find_slot(summary, summary->metrics[i].name)] = i;
+    }
+    return 1;
+}
+
+static void set_metric(RunSummary *summary, const char *name, double value)
+{
+    // Names are stored truncated, so they are looked up truncated too
+    char key[METRIC_NAME_LENGTH];
+    snprintf(key, sizeof(key), "%s", name);
+    if (summary->count == summary->capacity && !grow_summary(summary))
+    {
+        if (!summary->has_error)
+        {
+            printf("❌ Unable to allocate memory for metrics, '%s' and later metrics are missing.\n", key);
+        }
+        summary->has_error = true;
+        return;
+    }
+
+    int slot = find_slot(summary, key);
+    if (summary->slots[slot] != -1)
+    {
+        summary->metrics[summary->slots[slot]].value = value;
+        return;
+    }
+    memcpy(summary->metrics[summary->count].name, key, sizeof(key));
+    summary->metrics[summary->count].value = value;
+    summary->slots[slot] = summary->count;
+    summary->count++;
+}
+
+static int find_metric(const RunSummary *summary, const char *name, double *value)
+{
+    if (summary->count == 0)
+    {
+        return 0;
+    }
+    char key[METRIC_NAME_LENGTH];
+    snprintf(key, sizeof(key), "%s", name);
+    int slot = find_slot(summary, key);
+    if (summary->slots[slot] == -1)
+    {
+        return 0;
+    }
+    *value = summary->metrics[summary->slots[slot]].value;
+    return 1;
+}
+
+static void clean_up_summary(RunSummary *summary)
+{
+    free(summary->metrics);
+    free(summary->slots);
+    memset(summary, 0, sizeof(RunSummary));
+}
+
+// Objects inside arrays are labelled by their "vehicle_type" or "fuel_pump" member,
+// which is written before the numbers, but the numbers are buffered anyway in case it is not.
+static int read_array_of_objects(JsonTokenizer *tokenizer, const char *array_name, RunSummary *summary)
+{
+    int index = 0;
+    while (true)
+    {
+        JsonTokenType type = json_tokenizer_next(tokenizer);
+        if (type == JSON_TOKEN_END_ARRAY)
+        {
+            return 1;
+        }
+        if (type != JSON_TOKEN_BEGIN_OBJECT)
+        {
+            if (type == JSON_TOKEN_ERROR)
+            {
+                return 0;
+            }
+            index++;
+            continue;
+        }
+
+        char label[48];
+        snprintf(label, sizeof(label), "%s_%d", array_name, index + 1);
+        Metric metrics[MAX_ELEMENT_METRICS];
+        int metrics_count = 0;
+        char key[METRIC_NAME_LENGTH] = "";
+        while ((type = json_tokenizer_next(tokenizer)) != JSON_TOKEN_END_OBJECT)
+        {
+            if (type == JSON_TOKEN_ERROR)
+            {
+                return 0;
+            }
+            if (type != JSON_TOKEN_KEY)
+            {
+                continue;
+            }
+            snprintf(key, sizeof(key), "%s", tokenizer->text);
+            type = json_tokenizer_next(tokenizer);
+            if (type == JSON_TOKEN_STRING && strcmp(key, "vehicle_type") == 0)
+            {
+                snprintf(label, sizeof(label), "%s", tokenizer->text);
+            }
+            else if (type == JSON_TOKEN_NUMBER && strcmp(key, "fuel_pump") == 0)
+            {
+                snprintf(label, sizeof(label), "pump_%s", tokenizer->text);
+            }
+            else if (type == JSON_TOKEN_NUMBER && metrics_count < MAX_ELEMENT_METRICS)
+            {
+                snprintf(metrics[metrics_count].name, METRIC_NAME_LENGTH, "%s", key);
+                metrics[metrics_count].value = tokenizer->number;
+                metrics_count++;
+            }
+            else if ((type == JSON_TOKEN_BEGIN_OBJECT || type == JSON_TOKEN_BEGIN_ARRAY))
+            {
+                // Nested containers inside an element are not compared; skip the rest of it
+                int depth = 1;
+                while (depth > 0)
+                {
+                    type = json_tokenizer_next(tokenizer);
+                    if (type == JSON_TOKEN_ERROR || type == JSON_TOKEN_END)
+                    {
+                        return 0;
+                    }
+                    depth += (type == JSON_TOKEN_BEGIN_OBJECT || type == JSON_TOKEN_BEGIN_ARRAY);
+                    depth -= (type == JSON_TOKEN_END_OBJECT || type == JSON_TOKEN_END_ARRAY);
+                }
+            }
+            else if (type == JSON_TOKEN_ERROR)
+            {
+                return 0;
+            }
+        }
+
+        for (int i = 0; i < metrics_count; i++)
+        {
+            char name[METRIC_NAME_LENGTH];
+            snprintf(name, sizeof(name), "%.40s.%.50s", label, metrics[i].name);
+            set_metric(summary, name, metrics[i].value);
+        }
+        index++;
+    }
+}
+
+static int read_object(JsonTokenizer *tokenizer, const char *prefix, RunSummary *summary)
+{
+    while (true)
+    {
+        JsonTokenType type = json_tokenizer_next(tokenizer);
+        if (type == JSON_TOKEN_END_OBJECT)
+        {
+            return 1;
+        }
+        if (type != JSON_TOKEN_KEY)
+        {
+            return 0;
+        }
+
+        char name[METRIC_NAME_LENGTH];
+        if (prefix[0] == '\0')
+        {
+            snprintf(name, sizeof(name), "%s", tokenizer->text);
+        }
+        else
+        {
+            snprintf(name, sizeof(name), "%s.%s", prefix, tokenizer->text);
+        }
+        // One entry per vehicle, skipped without being kept in memory
+        if (strcmp(tokenizer->text, "stats_per_vehicle") == 0)
+        {
+            if (!json_tokenizer_skip_value(tokenizer))
+            {
+                return 0;
+            }
+            continue;
+        }
+        char key[METRIC_NAME_LENGTH];
+        snprintf(key, sizeof(key), "%s", tokenizer->text);
+
+        type = json_tokenizer_next(tokenizer);
+        if (type == JSON_TOKEN_NUMBER)
+        {
+            set_metric(summary, name, tokenizer->number);
+        }
+        else if (type == JSON_TOKEN_BEGIN_OBJECT)
+        {
+            if (!read_object(tokenizer, name, summary))
+            {
+                return 0;
+            }
+        }
+        else if (type == JSON_TOKEN_BEGIN_ARRAY)
+        {
+            if (!read_array_of_objects(tokenizer, key, summary))
+            {
+                return 0;
+            }
+        }
+        else if (type == JSON_TOKEN_ERROR || type == JSON_TOKEN_END_OBJECT || type == JSON_TOKEN_END_ARRAY)
+        {
+            return 0;
+        }
+    }
+}
+
+static int load_json_summary(const char *path, RunSummary *summary)
+{
+    JsonTokenizer *tokenizer = json_tokenizer_open(path);
+    if (tokenizer == NULL)
+    {
+        printf("❌ Unable to open '%s': %s\n", path, strerror(errno));
+        return 0;
+    }
+    int result = json_tokenizer_next(tokenizer) == JSON_TOKEN_BEGIN_OBJECT &&
+                 read_object(tokenizer, "", summary) &&
+                 json_tokenizer_next(tokenizer) == JSON_TOKEN_END;
+    if (!result)
+    {
+        printf("❌ '%s' is not a statistics file: %s\n", path, tokenizer->error[0] != '\0' ? tokenizer->error : "unexpected structure");
+    }
+    json_tokenizer_close(&tokenizer);
+    return result;
+}
+
+static void set_wait_time_metrics(RunSummary *summary, const char *prefix, const Histogram *histogram)
+{
+    const char *names[] = {"wait_time_p50_sec", "wait_time_p95_sec", "wait_time_p99_sec"};
+    const double percentiles[] = {50, 95, 99};
+    char name[METRIC_NAME_LENGTH];
+    for (int i = 0; i < 3; i++)
+    {
+        snprintf(name, sizeof(name), "%s.%s", prefix, names[i]);
+        set_metric(summary, name, histogram_get_percentile(histogram, percentiles[i]) / 1e6);
+    }
+    snprintf(name, sizeof(name), "%s.max_wait_time_sec", prefix);
+    set_metric(summary, name, histogram->max / 1e6);
+}
+
+static int load_columnar_summary(const char *path, RunSummary *summary)
+{
+    ColumnarFile *file = columnar_file_open(path);
+    if (file == NULL)
+    {
+        return 0;
+    }
+
+    uint64_t rows_count = file->header->rows_count;
+    const uint8_t *vehicle_types = (const uint8_t *)columnar_file_get_column(file, COLUMN_VEHICLE_TYPE);
+    const int32_t *fuel_required = (const int32_t *)columnar_file_get_column(file, COLUMN_FUEL_REQUIRED);
+    const int32_t *fuel_received = (const int32_t *)columnar_file_get_column(file, COLUMN_FUEL_RECEIVED);
+    const uint64_t *wait_ns = (const uint64_t *)columnar_file_get_column(file, COLUMN_WAIT_NS);
+    const uint8_t *outcomes = (const uint8_t *)columnar_file_get_column(file, COLUMN_OUTCOME);
+
+    // Last slot is the total over all vehicle types
+    Histogram *histograms = (Histogram *)malloc((VEHICLE_NOT_FOUND + 1) * sizeof(Histogram));
+    if (histograms == NULL)
+    {
+        printf("❌ Unable to allocate memory for histograms.\n");
+        columnar_file_close(&file);
+        return 0;
+    }
+    int64_t serviced[VEHICLE_NOT_FOUND + 1] = {0};
+    int64_t consumed[VEHICLE_NOT_FOUND + 1] = {0};
+    int64_t required[VEHICLE_NOT_FOUND + 1] = {0};
+    double total_wait_time = 0;
+    for (int i = 0; i <= VEHICLE_NOT_FOUND; i++)
+    {
+        histogram_init(&histograms[i]);
+    }
+
+    for (uint64_t row = 0; row < rows_count; row++)
+    {
+        int slots[2] = {vehicle_types[row] < VEHICLE_NOT_FOUND ? vehicle_types[row] : -1, VEHICLE_NOT_FOUND};
+        for (int i = 0; i < 2; i++)
+        {
+            if (slots[i] < 0)
+            {
+                continue;
+            }
+            serviced[slots[i]] += outcomes[row] == VEHICLE_OUTCOME_REFUELED;
+            consumed[slots[i]] += fuel_received[row];
+            required[slots[i]] += fuel_required[row];
+            histogram_record(&histograms[slots[i]], wait_ns[row] / 1000);
+        }
+        total_wait_time += wait_ns[row] / 1e9;
+    }
+
+    set_metric(summary, "gas_station_stats.total_fuel_consumed", consumed[VEHICLE_NOT_FOUND]);
+    set_metric(summary, "gas_station_stats.total_serviced_vehicles", serviced[VEHICLE_NOT_FOUND]);
+    set_metric(summary, "vehicles_stats.total_vehicles_in_queue", rows_count);
+    set_metric(summary, "vehicles_stats.average_wait_time_sec", rows_count > 0 ? total_wait_time / rows_count : 0);
+    set_wait_time_metrics(summary, "vehicles_stats", &histograms[VEHICLE_NOT_FOUND]);
+
+    const VehicleType vehicle_types_order[] = {VEHICLE_AUTO, VEHICLE_TRUCK, VEHICLE_VAN};
+    for (int i = 0; i < 3; i++)
+    {
+        VehicleType vehicle_type = vehicle_types_order[i];
+        const char *prefix = get_vehicle_type_name(vehicle_type);
+        char name[METRIC_NAME_LENGTH];
+        snprintf(name, sizeof(name), "%s.total_serviced_cars", prefix);
+        set_metric(summary, name, serviced[vehicle_type]);
+        snprintf(name, sizeof(name), "%s.total_fuel_consumed_by_all_cars", prefix);
+        set_metric(summary, name, consumed[vehicle_type]);
+        snprintf(name, sizeof(name), "%s.total_fuel_required_by_all_cars", prefix);
+        set_metric(summary, name, required[vehicle_type]);
+        set_wait_time_metrics(summary, prefix, &histograms[vehicle_type]);
+    }
+
+    free(histograms);
+    columnar_file_close(&file);
+    return 1;
+}
+
+static int load_summary(const char *path, RunSummary *summary)
+{
+    memset(summary, 0, sizeof(RunSummary));
+
+    char magic[sizeof(COLUMNAR_MAGIC)] = "";
+    int fd = open(path, O_RDONLY);
+    if (fd >= 0)
+    {
+        if (read(fd, magic, sizeof(magic)) != (ssize_t)sizeof(magic))
+        {
+            magic[0] = '\0';
+        }
+        close(fd);
+    }
+
+    int result = memcmp(magic, COLUMNAR_MAGIC, sizeof(COLUMNAR_MAGIC)) == 0 ? load_columnar_summary(path, summary) : load_json_summary(path, summary);
+
+    // Throughput is derived, the statistics file only has the totals
+    double serviced = 0;
+    double duration = 0;
+    if (result && find_metric(summary, "gas_station_stats.total_serviced_vehicles", &serviced) &&
+        find_metric(summary, "gas_station_stats.total_simulation_time_sec", &duration) && duration > 0)
+    {
+        set_metric(summary, "gas_station_stats.serviced_vehicles_per_sec", serviced / duration);
+    }
+    return result && !summary->has_error;
+}
+
+// Continued fraction for the incomplete beta function (modified Lentz's method)
+static double incomplete_beta_fraction(double a, double b, double x)
+{
+    const double epsilon = 3e-14;
+    const double tiny = 1e-300;
+    double c = 1;
+    double d = 1 - (a + b) * x / (a + 1);
+    d = 1 / (fabs(d) < tiny ? tiny : d);
+    double result = d;
+    for (int m = 1; m <= 300; m++)
+    {
+        double numerator = m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m));
+        d = 1 + numerator * d;
+        d = 1 / (fabs(d) < tiny ? tiny : d);
+        c = 1 + numerator / c;
+        c = fabs(c) < tiny ? tiny : c;
+        result *= d * c;
+
+        numerator = -(a + m) * (a + b + m) * x / ((a + 2 * m) * (a + 2 * m + 1));
+        d = 1 + numerator * d;
+        d = 1 / (fabs(d) < tiny ? tiny : d);
+        c = 1 + numerator / c;
+        c = fabs(c) < tiny ? tiny : c;
+        double delta = d * c;
+        result *= delta;
+        if (fabs(delta - 1) < epsilon)
+        {
+            break;
+        }
+    }
+    return result;
+}
+
+static double regularized_incomplete_beta(double a, double b, double x)
+{
+    if (x <= 0)
+    {
+        return 0;
+    }
+    if (x >= 1)
+    {
+        return 1;
+    }
+    double front = exp(lgamma(a + b) - lgamma(a) - lgamma(b) + a * log(x) + b * log(1 - x));
+    if (x < (a + 1) / (a + b + 2))
+    {
+        return front * incomplete_beta_fraction(a, b, x) / a;
+    }
+    return 1 - front * incomplete_beta_fraction(b, a, 1 - x) / b;
+}
+
+// Two-sided p-value of Welch's unequal-variances t-test
+static double welch_t_test(double mean_1, double variance_1, int n_1, double mean_2, double variance_2, int n_2)
+{
+    double standard_error_1 = variance_1 / n_1;
+    double standard_error_2 = variance_2 / n_2;
+    double standard_error = standard_error_1 + standard_error_2;
+    if (standard_error <= 0)
+    {
+        // Constant on both sides: anything beyond rounding noise is a real difference
+        return fabs(mean_1 - mean_2) <= 1e-9 * fmax(fabs(mean_1), fabs(mean_2)) ? 1 : 0;
+    }
+    double t = (mean_1 - mean_2) / sqrt(standard_error);
+    double degrees_of_freedom = standard_error * standard_error /
+                                (standard_error_1 * standard_error_1 / (n_1 - 1) + standard_error_2 * standard_error_2 / (n_2 - 1));
+    return regularized_incomplete_beta(degrees_of_freedom / 2, 0.5, degrees_of_freedom / (degrees_of_freedom + t * t));
+}
+
+// Mean and sample variance of [name] over the runs that have it (Welford, so equal values give exactly 0)
+static int get_metric_statistics(const RunSummary *runs, int runs_count, const char *name, double *mean, double *variance)
+{
+    int count = 0;
+    double m2 = 0;
+    *mean = 0;
+    for (int i = 0; i < runs_count; i++)
+    {
+        double value = 0;
+        if (find_metric(&runs[i], name, &value))
+        {
+            count++;
+            double delta = value - *mean;
+            *mean += delta / count;
+            m2 += delta * (value - *mean);
+        }
+    }
+    *variance = count > 1 ? m2 / (count - 1) : 0;
+    return count;
+}
+
+static void print_metric_diff(const RunSummary *baseline, int baseline_count, const RunSummary *candidate, int candidate_count, const char *name)
+{
+    double baseline_mean = 0;
+    double baseline_variance = 0;
+    double candidate_mean = 0;
+    double candidate_variance = 0;
+    int n_1 = get_metric_statistics(baseline, baseline_count, name, &baseline_mean, &baseline_variance);
+    int n_2 = get_metric_statistics(candidate, candidate_count, name, &candidate_mean, &candidate_variance);
+
+    printf("%-52s", name);
+    if (n_1 == 0)
+    {
+        printf(" %12s", "-");
+    }
+    else
+    {
+        printf(" %12.4g", baseline_mean);
+    }
+    if (n_2 == 0)
+    {
+        printf(" %12s", "-");
+    }
+    else
+    {
+        printf(" %12.4g", candidate_mean);
+    }
+    if (n_1 == 0 || n_2 == 0)
+    {
+        printf("\n");
+        return;
+    }
+
+    double delta = candidate_mean - baseline_mean;
+    printf(" %+12.4g", delta);
+    if (baseline_mean != 0)
+    {
+        printf(" %+8.1f%%", 100.0 * delta / fabs(baseline_mean));
+    }
+    else
+    {
+        printf(" %9s", "");
+    }
+    if (n_1 > 1 && n_2 > 1)
+    {
+        double p_value = welch_t_test(baseline_mean, baseline_variance, n_1, candidate_mean, candidate_variance, n_2);
+        printf("  p=%.3f%s", p_value, p_value < SIGNIFICANCE_LEVEL ? " *" : "");
+    }
+    printf("\n");
+}
+
+static void print_usage(const char *program_name)
+{
+    printf("Usage: %s <baseline> <candidate>\n", program_name);
+    printf("       %s <baseline>... --vs <candidate>...\n", program_name);
+    printf("\n");
+    printf("Inputs are statistics.json files or columnar results (--results). With two or more\n");
+    printf("replications on each side, means are compared with Welch's t-test (* marks p < %.2f).\n", SIGNIFICANCE_LEVEL);
+}
+
+static void free_runs(RunSummary *runs, int count)
+{
+    if (runs == NULL)
+    {
+        return;
+    }
+    for (int i = 0; i < count; i++)
+    {
+        clean_up_summary(&runs[i]);
+    }
+    free(runs);
+}
+
+static RunSummary *load_runs(char **paths, int count)
+{
+    RunSummary *runs = (RunSummary *)calloc(count, sizeof(RunSummary));
+    if (runs == NULL)
+    {
+        printf("❌ Unable to allocate memory for run summaries.\n");
+        return NULL;
+    }
+    for (int i = 0; i < count; i++)
+    {
+        if (!load_summary(paths[i], &runs[i]))
+        {
+            free_runs(runs, count);
+            return NULL;
+        }
+    }
+    return runs;
+}
+
+int main(int argc, char **argv)
+{
+    int separator = -1;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--vs") == 0)
+        {
+            separator = i;
+        }
+    }
+
+    char **baseline_paths = argv + 1;
+    char **candidate_paths = NULL;
+    int baseline_count = 0;
+    int candidate_count = 0;
+    if (separator == -1 && argc == 3)
+    {
+        baseline_count = 1;
+        candidate_paths = argv + 2;
+        candidate_count = 1;
+    }
+    else if (separator != -1)
+    {
+        baseline_count = separator - 1;
+        candidate_paths = argv + separator + 1;
+        candidate_count = argc - separator - 1;
+    }
+    if (baseline_count == 0 || candidate_count == 0)
+    {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    RunSummary *baseline = load_runs(baseline_paths, baseline_count);
+    RunSummary *candidate = baseline == NULL ? NULL : load_runs(candidate_paths, candidate_count);
+    if (baseline == NULL || candidate == NULL)
+    {
+        free_runs(baseline, baseline_count);
+        return 1;
+    }
+
+    printf("%-52s %12s %12s %12s %9s\n", "metric", "baseline", "candidate", "delta", "change");
+    // Metrics in the order of the first baseline, then whatever only the others have
+    RunSummary *all_runs[2] = {baseline, candidate};
+    int all_counts[2] = {baseline_count, candidate_count};
+    RunSummary printed;
+    memset(&printed, 0, sizeof(RunSummary));
+    for (int side = 0; side < 2; side++)
+    {
+        for (int run = 0; run < all_counts[side]; run++)
+        {
+            for (int i = 0; i < all_runs[side][run].count; i++)
+            {
+                const char *name = all_runs[side][run].metrics[i].name;
+                double unused = 0;
+                if (find_metric(&printed, name, &unused))
+                {
+                    continue;
+                }
+                set_metric(&printed, name, 0);
+                print_metric_diff(baseline, baseline_count, candidate, candidate_count, name);
+            }
+        }
+    }
+
+    int result = printed.has_error ? 1 : 0;
+    clean_up_summary(&printed);
+    free_runs(baseline, baseline_count);
+    free_runs(candidate, candidate_count);
+    return result;
+}
@@ -0,0 +1,568 @@
+#ifdef __linux__
+// "Let's go!"
+#else
+#error "Only __linux__ supported"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <errno.h>
+#include <math.h>
+#include <time.h>
+
+#include "util_buffered_writer.h"
+#include "util_read_data_parser.h"
+
+// Scenario files grow to gigabytes, so the writer gets a few large buffers
+#define GEN_WRITER_CAPACITY (4 * 1024 * 1024)
+#define GEN_LINE_LENGTH 256
+
+typedef enum
+{
+    DISTRIBUTION_FIXED,
+    DISTRIBUTION_UNIFORM,
+    DISTRIBUTION_NORMAL,
+    DISTRIBUTION_EXPONENTIAL,
+} DistributionKind;
+
+// fixed:V, uniform:MIN:MAX, normal:MEAN:STDDEV or exp:MEAN
+typedef struct
+{
+    DistributionKind kind;
+    double first;
+    double second;
+} Distribution;
+
+typedef struct
+{
+    const char *output_path;
+    int64_t vehicles_count;
+    double type_weights[VEHICLE_NOT_FOUND];
+    Distribution fuel;
+    Distribution wait;
+    double patient_ratio;
+    int64_t group_size;
+    int64_t entry_size;
+    int64_t fuel_pumps_count;
+    int64_t max_vehicle_capacity;
+    int64_t initial_fuel_in_tanker;
+    int64_t fuel_transfer_rate;
+    _Bool randomize_arrival;
+    uint64_t seed;
+} GeneratorOptions;
+
+typedef struct
+{
+    BufferedWriter *writer;
+    uint64_t bytes_written;
+    uint64_t random_state;
+} Generator;
+
+static void print_usage(const char *program)
+{
+    printf("Usage: %s [options]\n", program);
+    printf("   --output <file>          Scenario file, '-' for stdout (default: scenario.json)\n");
+    printf("   --vehicles <n>           Total vehicles (default: 100)\n");
+    printf("   --mix <type=weight,...>  Vehicle mix, e.g. auto=6,van=3,truck=1 (default: equal)\n");
+    printf("   --fuel <distribution>    Fuel per vehicle (default: uniform:5:60)\n");
+    printf("   --wait <distribution>    Wait time in seconds (default: uniform:1:10)\n");
+    printf("   --patient-ratio <r>      Share of vehicles that wait forever, 0..1 (default: 0)\n");
+    printf("   --group-size <n>         Up to n identical vehicles per waiting list item (default: 1)\n");
+    printf("   --entry-size <n>         Waiting list items per vehicle entry (default: 1000)\n");
+    printf("   --pumps <n>              fuel_pumps_count (default: 3)\n");
+    printf("   --capacity <n>           max_vehicle_capacity (default: all vehicles)\n");
+    printf("   --tanker-fuel <n>        initial_fuel_in_tanker (default: 500)\n");
+    printf("   --transfer-rate <n>      fuel_transfer_rate (default: 60)\n");
+    printf("   --randomize              Set randomize_arrival\n");
+    printf("   --seed <n>               Seed, the same options and seed give the same file (default: time)\n");
+    printf("Distributions: fixed:V, uniform:MIN:MAX, normal:MEAN:STDDEV, exp:MEAN\n");
+}
+
+static uint64_t next_random(uint64_t *state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Uniform in [0, 1)
+static double next_random_double(uint64_t *state)
+{
+    return (double)(next_random(state) >> 11) * 0x1.0p-53;
+}
+
+static double draw(const Distribution *distribution, uint64_t *state)
+{
+    switch (distribution->kind)
+    {
+    case DISTRIBUTION_UNIFORM:
+        // Both ends included once rounded
+        return distribution->first + next_random_double(state) * (distribution->second - distribution->first + 1.0) - 0.5;
+    case DISTRIBUTION_NORMAL:
+    {
+        // Box-Muller, 1 - u keeps log() away from 0
+        double u = 1.0 - next_random_double(state);
+        double v = next_random_double(state);
+        return distribution->first + distribution->second * sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * v);
+    }
+    case DISTRIBUTION_EXPONENTIAL:
+        return -distribution->first * log(1.0 - next_random_double(state));
+    default:
+        return distribution->first;
+    }
+}
+
+// Rounded and clamped to what the parser accepts for this field
+static int draw_int(const Distribution *distribution, uint64_t *state, int min_value)
+{
+    double value = round(draw(distribution, state));
+    // Also catches NaN, which has no int conversion
+    if (!(value >= min_value))
+    {
+        return min_value;
+    }
+    return value > INT_MAX ? INT_MAX : (int)value;
+}
+
+static int parse_int64(const char *option, const char *value, int64_t min_value, int64_t *result)
+{
+    char *end = NULL;
+    errno = 0;
+    long long parsed = strtoll(value, &end, 10);
+    if (end == value || *end != '\0' || errno == ERANGE || parsed < min_value)
+    {
+        printf("❌ [%s]: Invalid value '%s'. Expected a number of at least %" PRId64 ".\n", option, value, min_value);
+        return 0;
+    }
+    *result = (int64_t)parsed;
+    return 1;
+}
+
+static int parse_distribution(const char *option, const char *value, Distribution *distribution)
+{
+    char name[16] = "";
+    double first = 0;
+    double second = 0;
+    int fields_count = sscanf(value, "%15[a-z]:%lf:%lf", name, &first, &second);
+    // sscanf accepts "nan" and "inf"; the span check keeps uniform:-1e308:1e308 from overflowing
+    int is_valid = 0;
+    if (!isfinite(first) || !isfinite(second) || !isfinite(second - first))
+    {
+        printf("❌ [%s]: Invalid distribution '%s'. Parameters must be finite.\n", option, value);
+        return 0;
+    }
+    if (strcmp(name, "fixed") == 0 && fields_count == 2)
+    {
+        distribution->kind = DISTRIBUTION_FIXED;
+        is_valid = 1;
+    }
+    else if (strcmp(name, "uniform") == 0 && fields_count == 3 && first <= second)
+    {
+        distribution->kind = DISTRIBUTION_UNIFORM;
+        is_valid = 1;
+    }
+    else if (strcmp(name, "normal") == 0 && fields_count == 3 && second >= 0)
+    {
+        distribution->kind = DISTRIBUTION_NORMAL;
+        is_valid = 1;
+    }
+    else if (strcmp(name, "exp") == 0 && fields_count == 2 && first > 0)
+    {
+        distribution->kind = DISTRIBUTION_EXPONENTIAL;
+        is_valid = 1;
+    }
+    if (!is_valid)
+    {
+        printf("❌ [%s]: Invalid distribution '%s'.\n", option, value);
+        return 0;
+    }
+    distribution->first = first;
+    distribution->second = second;
+    return 1;
+}
+
+static int parse_mix(const char *value, double *type_weights)
+{
+    for (int i = 0; i < VEHICLE_NOT_FOUND; i++)
+    {
+        type_weights[i] = 0;
+    }
+    double total_weight = 0;
+    const char *cursor = value;
+    while (*cursor != '\0')
+    {
+        char name[16] = "";
+        double weight = 0;
+        int length = 0;
+        if (sscanf(cursor, "%15[a-z]=%lf%n", name, &weight, &length) != 2 || !isfinite(weight) || weight < 0)
+        {
+            printf("❌ [--mix]: Invalid vehicle mix '%s'.\n", value);
+            return 0;
+        }
+        int vehicle_type = 0;
+        while (vehicle_type < VEHICLE_NOT_FOUND && strcmp(get_vehicle_type_name((VehicleType)vehicle_type), name) != 0)
+        {
+            vehicle_type++;
+        }
+        if (vehicle_type == VEHICLE_NOT_FOUND)
+        {
+            printf("❌ [--mix]: Unknown vehicle type '%s'.\n", name);
+            return 0;
+        }
+        type_weights[vehicle_type] = weight;
+        total_weight += weight;
+        cursor += length;
+        if (*cursor == ',')
+        {
+            cursor++;
+        }
+    }
+    if (!isfinite(total_weight) || total_weight <= 0)
+    {
+        printf("❌ [--mix]: At least one vehicle type needs a positive weight.\n");
+        return 0;
+    }
+    return 1;
+}
+
+static int parse_arguments(int argc, char **argv, GeneratorOptions *options)
+{
+    options->output_path = "scenario.json";
+    options->vehicles_count = 100;
+    for (int i = 0; i < VEHICLE_NOT_FOUND; i++)
+    {
+        options->type_weights[i] = 1;
+    }
+    options->fuel = (Distribution){DISTRIBUTION_UNIFORM, 5, 60};
+    options->wait = (Distribution){DISTRIBUTION_UNIFORM, 1, 10};
+    options->patient_ratio = 0;
+    options->group_size = 1;
+    options->entry_size = 1000;
+    options->fuel_pumps_count = 3;
+    options->max_vehicle_capacity = 0;
+    options->initial_fuel_in_tanker = 500;
+    options->fuel_transfer_rate = 60;
+    options->randomize_arrival = false;
+    options->seed = (uint64_t)time(NULL);
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *option = argv[i];
+        if (strcmp(option, "--help") == 0 || strcmp(option, "-h") == 0)
+        {
+            print_usage(argv[0]);
+            exit(0);
+        }
+        if (strcmp(option, "--randomize") == 0)
+        {
+            options->randomize_arrival = true;
+            continue;
+        }
+        if (i + 1 >= argc)
+        {
+            printf("❌ [%s]: Unknown option or missing value.\n", option);
+            return 0;
+        }
+        const char *value = argv[++i];
+        int result = 1;
+        int64_t seed = 0;
+        if (strcmp(option, "--output") == 0)
+        {
+            options->output_path = value;
+        }
+        else if (strcmp(option, "--vehicles") == 0)
+        {
+            result = parse_int64(option, value, 1, &options->vehicles_count);
+        }
+        else if (strcmp(option, "--mix") == 0)
+        {
+            result = parse_mix(value, options->type_weights);
+        }
+        else if (strcmp(option, "--fuel") == 0)
+        {
+            result = parse_distribution(option, value, &options->fuel);
+        }
+        else if (strcmp(option, "--wait") == 0)
+        {
+            result = parse_distribution(option, value, &options->wait);
+        }
+        else if (strcmp(option, "--patient-ratio") == 0)
+        {
+            char *end = NULL;
+            options->patient_ratio = strtod(value, &end);
+            if (end == value || *end != '\0' || !(options->patient_ratio >= 0 && options->patient_ratio <= 1))
+            {
+                printf("❌ [%s]: Invalid value '%s'. Expected a number from 0 to 1.\n", option, value);
+                result = 0;
+            }
+        }
+        else if (strcmp(option, "--group-size") == 0)
+        {
+            result = parse_int64(option, value, 1, &options->group_size);
+        }
+        else if (strcmp(option, "--entry-size") == 0)
+        {
+            result = parse_int64(option, value, 1, &options->entry_size);
+        }
+        else if (strcmp(option, "--pumps") == 0)
+        {
+            result = parse_int64(option, value, 1, &options->fuel_pumps_count);
+            // fuel_pumps_count is an int in the parser, a larger file would be rejected
+            if (result && options->fuel_pumps_count > INT_MAX)
+            {
+                printf("❌ [%s]: Invalid value '%s'. Expected a number of at most %d.\n", option, value, INT_MAX);
+                result = 0;
+            }
+        }
+        else if (strcmp(option, "--capacity") == 0)
+        {
+            result = parse_int64(option, value, 1, &options->max_vehicle_capacity);
+        }
+        else if (strcmp(option, "--tanker-fuel") == 0)
+        {
+            result = parse_int64(option, value, 1, &options->initial_fuel_in_tanker);
+        }
+        else if (strcmp(option, "--transfer-rate") == 0)
+        {
+            result = parse_int64(option, value, 1, &options->fuel_transfer_rate);
+        }
+        else if (strcmp(option, "--seed") == 0)
+        {
+            result = parse_int64(option, value, 0, &seed);
+            options->seed = (uint64_t)seed;
+        }
+        else
+        {
+            printf("❌ [%s]: Unknown option.\n", option);
+            result = 0;
+        }
+        if (!result)
+        {
+            return 0;
+        }
+    }
+    if (options->max_vehicle_capacity == 0)
+    {
+        options->max_vehicle_capacity = options->vehicles_count;
+    }
+    return 1;
+}
+
+static void write_text(Generator *generator, const char *text, size_t length)
+{
+    buffered_writer_write(generator->writer, text, length);
+    generator->bytes_written += length;
+}
+
+#define WRITE_LITERAL(generator, literal) write_text((generator), (literal), sizeof(literal) - 1)
+#define copy_literal(cursor, literal) ((char *)memcpy((cursor), (literal), sizeof(literal) - 1) + sizeof(literal) - 1)
+
+static void write_int_field(Generator *generator, const char *indent, const char *key, int64_t value, _Bool is_last)
+{
+    char line[GEN_LINE_LENGTH];
+    int length = snprintf(line, sizeof(line), "%s\"%s\": %" PRId64 "%s\n", indent, key, value, is_last ? "" : ",");
+    write_text(generator, line, (size_t)length);
+}
+
+static VehicleType draw_vehicle_type(const GeneratorOptions *options, uint64_t *state)
+{
+    double total_weight = 0;
+    for (int i = 0; i < VEHICLE_NOT_FOUND; i++)
+    {
+        total_weight += options->type_weights[i];
+    }
+    double target = next_random_double(state) * total_weight;
+    int last_type = 0;
+    for (int i = 0; i < VEHICLE_NOT_FOUND; i++)
+    {
+        if (options->type_weights[i] <= 0)
+        {
+            continue;
+        }
+        if (target < options->type_weights[i])
+        {
+            return (VehicleType)i;
+        }
+        target -= options->type_weights[i];
+        last_type = i;
+    }
+    // Rounding can leave [target] just past the last weight
+    return (VehicleType)last_type;
+}
+
+static void write_entry_header(Generator *generator, VehicleType vehicle_type, _Bool is_first)
+{
+    char line[GEN_LINE_LENGTH];
+    int length = snprintf(line, sizeof(line), "%s        {\n            \"vehicle_type\": \"%s\",\n",
+                          is_first ? "" : ",\n", get_vehicle_type_name(vehicle_type));
+    write_text(generator, line, (size_t)length);
+    // Only used by the parser when the waiting list is empty, every item below sets its own values
+    WRITE_LITERAL(generator, "            \"default_fuel_needed\": 1,\n"
+                             "            \"default_wait_time_sec\": 0,\n"
+                             "            \"default_count\": 1,\n"
+                             "            \"custom_waiting_list\": [\n");
+}
+
+// One line per waiting list item, formatted by hand: this loop is where the gigabytes come from
+static void write_item(Generator *generator, int wait_time_sec, int fuel_needed, int64_t count, _Bool is_first)
+{
+    char line[GEN_LINE_LENGTH];
+    char *cursor = line;
+    if (!is_first)
+    {
+        *cursor++ = ',';
+        *cursor++ = '\n';
+    }
+    cursor = copy_literal(cursor, "                { \"wait_time_sec\": ");
+    cursor = format_int64(cursor, wait_time_sec);
+    cursor = copy_literal(cursor, ", \"fuel_needed\": ");
+    cursor = format_int64(cursor, fuel_needed);
+    cursor = copy_literal(cursor, ", \"count\": ");
+    cursor = format_int64(cursor, count);
+    cursor = copy_literal(cursor, " }");
+    write_text(generator, line, (size_t)(cursor - line));
+}
+
+static void write_entry_footer(Generator *generator)
+{
+    WRITE_LITERAL(generator, "\n            ]\n        }");
+}
+
+static void write_scenario(Generator *generator, const GeneratorOptions *options, int64_t *items_count)
+{
+    WRITE_LITERAL(generator, "{\n");
+    write_int_field(generator, "    ", "fuel_pumps_count", options->fuel_pumps_count, false);
+    if (options->randomize_arrival)
+    {
+        WRITE_LITERAL(generator, "    \"randomize_arrival\": true,\n");
+    }
+    else
+    {
+        WRITE_LITERAL(generator, "    \"randomize_arrival\": false,\n");
+    }
+    write_int_field(generator, "    ", "max_vehicle_capacity", options->max_vehicle_capacity, false);
+    write_int_field(generator, "    ", "initial_fuel_in_tanker", options->initial_fuel_in_tanker, false);
+    write_int_field(generator, "    ", "fuel_transfer_rate", options->fuel_transfer_rate, false);
+    WRITE_LITERAL(generator, "    \"vehicles\": [\n");
+
+    // Each item draws its type, so the mix stays interleaved in arrival order;
+    // a new entry starts when the type changes or the entry is full
+    int64_t remaining = options->vehicles_count;
+    int64_t items_in_entry = 0;
+    VehicleType entry_type = VEHICLE_NOT_FOUND;
+    _Bool is_first_entry = true;
+    *items_count = 0;
+    while (remaining > 0)
+    {
+        VehicleType vehicle_type = draw_vehicle_type(options, &generator->random_state);
+        if (vehicle_type != entry_type || items_in_entry == options->entry_size)
+        {
+            if (entry_type != VEHICLE_NOT_FOUND)
+            {
+                write_entry_footer(generator);
+            }
+            write_entry_header(generator, vehicle_type, is_first_entry);
+            is_first_entry = false;
+            entry_type = vehicle_type;
+            items_in_entry = 0;
+        }
+
+        int64_t count = 1;
+        if (options->group_size > 1)
+        {
+            count += (int64_t)(next_random(&generator->random_state) % (uint64_t)options->group_size);
+        }
+        if (count > remaining)
+        {
+            count = remaining;
+        }
+        int fuel_needed = draw_int(&options->fuel, &generator->random_state, 1);
+        int wait_time_sec = next_random_double(&generator->random_state) < options->patient_ratio
+                                ? -1
+                                : draw_int(&options->wait, &generator->random_state, 0);
+        write_item(generator, wait_time_sec, fuel_needed, count, items_in_entry == 0);
+
+        items_in_entry++;
+        (*items_count)++;
+        remaining -= count;
+    }
+    write_entry_footer(generator);
+    WRITE_LITERAL(generator, "\n    ]\n}\n");
+}
+
+// The `--max-*` options `validation` and `gas_station` need for this file, empty if none
+static size_t get_limit_hint(const GeneratorOptions *options, char *hint, size_t hint_size)
+{
+    size_t length = 0;
+    hint[0] = '\0';
+    if (options->max_vehicle_capacity > DEFAULT_MAX_VEHICLES)
+    {
+        length += snprintf(hint + length, hint_size - length, " --max-vehicles %" PRId64, options->max_vehicle_capacity);
+    }
+    if (options->fuel_pumps_count > DEFAULT_MAX_FUEL_PUMPS_COUNT)
+    {
+        length += snprintf(hint + length, hint_size - length, " --max-fuel-pumps %" PRId64, options->fuel_pumps_count);
+    }
+    if (options->initial_fuel_in_tanker > DEFAULT_MAX_INITIAL_FUEL_IN_TANKER)
+    {
+        length += snprintf(hint + length, hint_size - length, " --max-tanker-fuel %" PRId64, options->initial_fuel_in_tanker);
+    }
+    if (options->fuel_transfer_rate > DEFAULT_MAX_FUEL_TRANSFER_RATE)
+    {
+        length += snprintf(hint + length, hint_size - length, " --max-transfer-rate %" PRId64, options->fuel_transfer_rate);
+    }
+    return length;
+}
+
+int main(int argc, char **argv)
+{
+    GeneratorOptions options;
+    if (!parse_arguments(argc, argv, &options))
+    {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    Generator generator;
+    generator.bytes_written = 0;
+    generator.random_state = options.seed;
+    generator.writer = buffered_writer_open_async(options.output_path, GEN_WRITER_CAPACITY);
+    if (generator.writer == NULL)
+    {
+        return 1;
+    }
+
+    struct timespec start;
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int64_t items_count = 0;
+    write_scenario(&generator, &options, &items_count);
+    int result = buffered_writer_close(&generator.writer);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    if (!result)
+    {
+        printf("❌ Failed to write scenario '%s'.\n", options.output_path);
+        return 1;
+    }
+
+    // The scenario itself may be on stdout
+    FILE *output = strcmp(options.output_path, "-") == 0 ? stderr : stdout;
+    double duration_sec = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    double size_mb = generator.bytes_written / (1024.0 * 1024.0);
+    fprintf(output, "✅ Scenario '%s' generated (seed %" PRIu64 ").\n", options.output_path, options.seed);
+    fprintf(output, "   ├─ 🚘 Vehicles: %" PRId64 " in %" PRId64 " waiting list items\n", options.vehicles_count, items_count);
+    char hint[GEN_LINE_LENGTH];
+    _Bool has_hint = get_limit_hint(&options, hint, sizeof(hint)) > 0;
+    fprintf(output, "   %s─ ⏳ %.1f MB in %.3f seconds (%.1f MB/s)\n", has_hint ? "├" : "└", size_mb, duration_sec,
+            duration_sec > 0 ? size_mb / duration_sec : 0.0);
+    if (has_hint)
+    {
+        fprintf(output, "   └─ 💡 Above the default limits, validate with: ./validation %s%s\n", options.output_path, hint);
+    }
+    return 0;
+}
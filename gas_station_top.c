@@ -0,0 +1,184 @@
+#ifdef __linux__
+// "Let's go!"
+#else
+#error "Only __linux__ supported"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <dirent.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "util_live_stats.h"
+
+// Where glibc keeps POSIX shared memory objects
+#define SHM_DIRECTORY "/dev/shm"
+#define DEFAULT_REFRESH_INTERVAL_MS 1000
+
+// Copy of the segment, free() it when done
+static LiveStatistics *read_segment(const char *name)
+{
+    char path[300];
+    snprintf(path, sizeof(path), "/%s", name);
+    int fd = shm_open(path, O_RDONLY, 0);
+    if (fd < 0)
+    {
+        return NULL;
+    }
+    struct stat segment_stat;
+    if (fstat(fd, &segment_stat) != 0 || (size_t)segment_stat.st_size < sizeof(LiveStatistics))
+    {
+        close(fd);
+        return NULL;
+    }
+    size_t size = (size_t)segment_stat.st_size;
+    void *data = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        return NULL;
+    }
+    LiveStatistics *copy = live_stats_read((const LiveStatistics *)data, size);
+    munmap(data, size);
+    return copy;
+}
+
+static const char *get_state_name(const LiveStatistics *live_stats)
+{
+    if (live_stats->is_finished)
+    {
+        return "finished";
+    }
+    // The segment of a killed simulator stays behind until someone removes it
+    if (kill(live_stats->pid, 0) != 0 && errno == ESRCH)
+    {
+        return "dead";
+    }
+    return "running";
+}
+
+static void print_instance(const LiveStatistics *live_stats)
+{
+    uint64_t seconds = live_stats->elapsed_ns / 1000000000ULL;
+    char elapsed[16];
+    snprintf(elapsed, sizeof(elapsed), "%02" PRIu64 ":%02" PRIu64 ":%02" PRIu64, seconds / 3600, (seconds / 60) % 60, seconds % 60);
+
+    printf("%-8d %-9s %8" PRId64 " %8" PRId64 " %6d %6d %4d/%-4d %5" PRId64 "/%-4" PRId64 " %5" PRId64 "/%-4" PRId64 " %5" PRId64 "/%-4" PRId64 " %s\n",
+           live_stats->pid, elapsed,
+           live_stats->station.fuel_storage, live_stats->station.fuel_left,
+           live_stats->station.cars_waiting_for_pump, live_stats->station.cars_waiting_for_fuel,
+           live_stats->station.occupied_pumps, live_stats->fuel_pumps_count,
+           live_stats->vehicles_serviced[VEHICLE_AUTO], live_stats->vehicles_left_without_fuel[VEHICLE_AUTO],
+           live_stats->vehicles_serviced[VEHICLE_VAN], live_stats->vehicles_left_without_fuel[VEHICLE_VAN],
+           live_stats->vehicles_serviced[VEHICLE_TRUCK], live_stats->vehicles_left_without_fuel[VEHICLE_TRUCK],
+           get_state_name(live_stats));
+
+    printf("         ");
+    for (int i = 0; i < live_stats->fuel_pumps_count; i++)
+    {
+        const LivePumpState *pump = &live_stats->pumps[i];
+        if (pump->vehicle_id == -1)
+        {
+            printf(" ⛽️ #%d free (%d)", i + 1, pump->vehicles_serviced);
+        }
+        else
+        {
+            printf(" ⛽️ #%d car %d (%d)", i + 1, pump->vehicle_id, pump->vehicles_serviced);
+        }
+    }
+    printf("\n");
+}
+
+static int print_table()
+{
+    DIR *directory = opendir(SHM_DIRECTORY);
+    if (directory == NULL)
+    {
+        perror("❌ Unable to open " SHM_DIRECTORY);
+        return 0;
+    }
+
+    printf("%-8s %-9s %8s %8s %6s %6s %9s %10s %10s %10s %s\n",
+           "PID", "ELAPSED", "STORAGE", "TANKERS", "QUEUE", "WAIT", "PUMPS", "AUTO", "VAN", "TRUCK", "STATE");
+    int instances = 0;
+    struct dirent *entry = NULL;
+    while ((entry = readdir(directory)) != NULL)
+    {
+        if (strncmp(entry->d_name, LIVE_STATS_NAME_PREFIX, strlen(LIVE_STATS_NAME_PREFIX)) != 0)
+        {
+            continue;
+        }
+        LiveStatistics *live_stats = read_segment(entry->d_name);
+        if (live_stats != NULL)
+        {
+            print_instance(live_stats);
+            free(live_stats);
+            instances++;
+        }
+    }
+    closedir(directory);
+
+    if (instances == 0)
+    {
+        printf("No running simulations. Start one with `gas_station --live`.\n");
+    }
+    printf("\nTANKERS: fuel not delivered yet, QUEUE: cars waiting for a pump, WAIT: cars waiting for fuel, AUTO/VAN/TRUCK: serviced/left without fuel.\n");
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    _Bool is_once = false;
+    int refresh_interval_ms = DEFAULT_REFRESH_INTERVAL_MS;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--once") == 0)
+        {
+            is_once = true;
+        }
+        else if (strcmp(argv[i], "--interval") == 0 && i + 1 < argc)
+        {
+            refresh_interval_ms = atoi(argv[++i]);
+            if (refresh_interval_ms <= 0)
+            {
+                refresh_interval_ms = DEFAULT_REFRESH_INTERVAL_MS;
+            }
+        }
+        else
+        {
+            printf("Usage: %s [--once] [--interval <ms>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (is_once)
+    {
+        return print_table() ? 0 : 1;
+    }
+
+    struct timespec interval;
+    interval.tv_sec = refresh_interval_ms / 1000;
+    interval.tv_nsec = (long)(refresh_interval_ms % 1000) * 1000000L;
+    while (true)
+    {
+        // Clear the screen and move the cursor home
+        printf("\033[H\033[2J");
+        if (!print_table())
+        {
+            return 1;
+        }
+        fflush(stdout);
+        nanosleep(&interval, NULL);
+    }
+    return 0;
+}
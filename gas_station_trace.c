@@ -0,0 +1,146 @@
+#ifdef __linux__
+// "Let's go!"
+#else
+#error "Only __linux__ supported"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "util_trace.h"
+
+#define RECORDS_PER_READ 4096
+
+static char *get_trace_time(uint64_t timestamp_ns, char *formatted_time)
+{
+    uint64_t seconds = timestamp_ns / 1000000000ULL;
+    snprintf(formatted_time, 16, "%02" PRIu64 ":%02" PRIu64 ":%02" PRIu64,
+             (seconds / 3600) % 100, (seconds / 60) % 60, seconds % 60);
+    return formatted_time;
+}
+
+void print_record_text(const TraceRecord *record)
+{
+    char formatted_time[16];
+    get_trace_time(record->timestamp_ns, formatted_time);
+
+    if (record->kind == EVENT_TANKER_UNLOAD)
+    {
+        printf("[%s] 🚚 #%u: 🛢️  Unloaded %" PRId64 " liters of fuel. Station storage now holds: %" PRId64 " liters.\n",
+               formatted_time, record->vehicle_id, record->fuel, record->storage_after);
+        return;
+    }
+
+    printf("[%s] %s #%u: ", formatted_time, get_vehicle_icon((VehicleType)record->vehicle_type), record->vehicle_id);
+    switch (record->kind)
+    {
+    case EVENT_ARRIVAL:
+        printf("Arrived at the station, %" PRId64 " liters needed.\n", record->fuel);
+        break;
+    case EVENT_PUMP_OCCUPY:
+        printf("⛽️ Occupied fuel pump #%d. Attempting to get fuel...\n", record->pump_id + 1);
+        break;
+    case EVENT_PUMP_FREE:
+        printf("⛽️ Freed fuel pump #%d.\n", record->pump_id + 1);
+        break;
+    case EVENT_FUEL_WAIT:
+        printf("❌ Not enough fuel, waiting for delivery...\n");
+        break;
+    case EVENT_REFUEL:
+        printf("✅ Successfully refueled %" PRId64 " liters. Remaining fuel at station: %" PRId64 " liters.\n", record->fuel, record->storage_after);
+        break;
+    case EVENT_TIMEOUT:
+        printf("❌ Time's up. Fuel wasn't delivered in time. Leaving the station...\n");
+        break;
+    case EVENT_NO_FUEL:
+        printf("❌ Not enough fuel. Leaving gas station...\n");
+        break;
+    default:
+        printf("❓ Unknown event %u.\n", record->kind);
+        break;
+    }
+}
+
+void print_record_csv(const TraceRecord *record)
+{
+    printf("%" PRIu64 ",%s,%u,%s,%d,%" PRId64 ",%" PRId64 "\n",
+           record->timestamp_ns,
+           get_event_kind_name((EventKind)record->kind),
+           record->vehicle_id,
+           record->kind == EVENT_TANKER_UNLOAD ? "tanker" : get_vehicle_type_name((VehicleType)record->vehicle_type),
+           record->pump_id,
+           record->fuel,
+           record->storage_after);
+}
+
+int main(int argc, char **argv)
+{
+    char *path = NULL;
+    _Bool is_csv = false;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--csv") == 0)
+        {
+            is_csv = true;
+        }
+        else
+        {
+            path = argv[i];
+        }
+    }
+    if (path == NULL)
+    {
+        printf("Usage: %s <trace.gst> [--csv]\n", argv[0]);
+        return 1;
+    }
+
+    FILE *fp = fopen(path, "rb");
+    if (fp == NULL)
+    {
+        perror("❌ Unable to open the trace file");
+        return 1;
+    }
+
+    TraceHeader header;
+    if (fread(&header, sizeof(TraceHeader), 1, fp) != 1 || memcmp(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0)
+    {
+        printf("❌ '%s' is not a gas station trace file.\n", path);
+        fclose(fp);
+        return 1;
+    }
+    if (header.version != TRACE_VERSION || header.record_size != sizeof(TraceRecord))
+    {
+        printf("❌ Unsupported trace version %u (record size %u).\n", header.version, header.record_size);
+        fclose(fp);
+        return 1;
+    }
+
+    if (is_csv)
+    {
+        printf("timestamp_ns,kind,vehicle_id,vehicle_type,pump_id,fuel,storage_after\n");
+    }
+
+    static TraceRecord records[RECORDS_PER_READ];
+    size_t records_read = 0;
+    while ((records_read = fread(records, sizeof(TraceRecord), RECORDS_PER_READ, fp)) > 0)
+    {
+        for (size_t i = 0; i < records_read; i++)
+        {
+            if (is_csv)
+            {
+                print_record_csv(&records[i]);
+            }
+            else
+            {
+                print_record_text(&records[i]);
+            }
+        }
+    }
+
+    fclose(fp);
+    return 0;
+}
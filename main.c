@@ -18,9 +18,24 @@
 #include <bits/local_lim.h>
 #include <sys/sysinfo.h>
 #include <semaphore.h>
+#include <inttypes.h>
 
 #include "util_read_data_parser.h"
 #include "utils.h"
+#include "util_events.h"
+#include "util_trace.h"
+#include "util_chrome_trace.h"
+#include "util_event_stream.h"
+#include "util_json_writer.h"
+#include "util_histogram.h"
+#include "util_statistics.h"
+#include "util_columnar.h"
+#include "util_snapshot.h"
+#include "util_sampler.h"
+#include "util_metrics.h"
+#include "util_live_stats.h"
+#include "util_estimate.h"
+#include "util_compiled_scenario.h"
 
 typedef struct
 {
@@ -32,16 +47,31 @@ typedef struct
     time_t end_waiting_time;
     int fuel_required;
     bool is_left_without_fuel;
+    VehicleOutcome outcome;
+    uint64_t wait_time_ns;
 } Car;
 
 typedef struct
 {
-    int fuel_total;
-    int fuel_per_time;
+    int64_t fuel_total;
+    int64_t fuel_per_time;
     int number;
     int total_fuel_deliveries;
+    time_t start_unloading_time;
+    time_t end_unloading_time;
 } Tanker;
 
+// Occupancy of one fuel pump, updated under `dynamic_lock`.
+// Occupied time is split into waiting for a fuel delivery and dispensing (everything else).
+typedef struct
+{
+    int vehicles_serviced;
+    int64_t fuel_dispensed;
+    uint64_t occupied_since_ns;
+    uint64_t busy_ns;
+    uint64_t fuel_wait_ns;
+} FuelPump;
+
 void init_attributes_with_min_stack_size(pthread_attr_t *attributes_p);
 int setup_main();
 void clean_up_main();
@@ -50,60 +80,103 @@ int free_fuel_pump(int car_id, VehicleType vehicle_type);
 int get_number_of_free_fuel_pumps();
 int get_number_of_occupied_fuel_pumps();
 void print_statistics(Car *cars, Tanker *tankers);
+int write_statistics_json(Car *cars, Tanker *tankers);
+int write_results_columns(Car *cars);
 void print_tanker_statistics(Tanker *tankers);
 void print_car_statistics(Car *cars);
-void print_fuel_pumps_statistics(Car *cars);
+void print_fuel_pumps_statistics();
+void print_wait_time_statistics(const VehicleStatistics *total);
+void get_total_vehicle_statistics(VehicleStatistics *result);
 int read_json();
 int init_simulation_data();
+int parse_arguments(int argc, char **argv);
+void print_usage(char *program_name);
+void record_event(EventKind kind, int vehicle_id, VehicleType vehicle_type, int pump_id, int64_t fuel, int64_t storage_after);
+void publish_station_snapshot();
+int print_estimate_comparison();
 
 pthread_mutex_t dynamic_lock = PTHREAD_MUTEX_INITIALIZER;
 pthread_cond_t dynamic_cond = PTHREAD_COND_INITIALIZER;
 sem_t fuel_pump_semaphore;
 
-static int gas_station_fuel_storage = 0;
-static int total_fuel_left = 0;
+static int64_t gas_station_fuel_storage = 0;
+static int64_t total_fuel_left = 0;
 
 static int number_of_fuel_pumps = 1;
 static int number_of_cars = 1;
 static int tankers_number = 1;
-static int fuel_per_time = 15;
-static int fuel_in_tanker = 150;
+static int64_t fuel_per_time = 15;
+static int64_t fuel_in_tanker = 150;
 static int fuel_pump_occupied = 0;
+static int cars_waiting_for_fuel = 0;
+static int fuel_deliveries = 0;
 static int *fuel_pumps_list = NULL;
+static FuelPump *fuel_pumps = NULL;
+static Car *cars_list = NULL;
+static pthread_t *car_threads = NULL;
+static uint64_t simulation_duration_ns = 0;
+
+// One shard per fuel pump, written by the car holding the pump and merged after the run
+static StatisticsShard *statistics_shards = NULL;
+static VehicleStatistics vehicle_statistics[VEHICLE_NOT_FOUND];
 
 static ReadDataParserResult *read_data_parser_result = NULL;
+static CompiledScenario *compiled_scenario = NULL;
+// Either the parsed JSON or the mapped compiled scenario
+static UserJsonResult *scenario = NULL;
+static char *scenario_path = "data.json";
+
+static char *trace_path = NULL;
+static char *chrome_trace_path = NULL;
+static char *events_format = NULL;
+static char *events_path = "events.jsonl";
+static char *statistics_path = "statistics.json";
+static char *results_path = NULL;
+static char *samples_path = NULL;
+static SamplesFormat samples_format = SAMPLES_FORMAT_CSV;
+static int sample_interval_ms = SAMPLER_DEFAULT_INTERVAL_MS;
+static char *metrics_address = NULL;
+static bool is_live_stats_enabled = false;
+// `--estimate` skips the simulation, `--estimate-compare` runs it and checks it against the estimate
+static bool is_estimate_enabled = false;
+static bool is_estimate_compared = false;
+static QueueEstimate queue_estimate;
 
 void *tanker(void *thread_data)
 {
     Tanker *tanker_data = (Tanker *)thread_data;
     // int fuel_in_tanker = tanker_data.fuel_total;
-    int fuel_per_time_default = tanker_data->fuel_per_time;
+    int64_t fuel_per_time_default = tanker_data->fuel_per_time;
     int tanker_id = tanker_data->number;
 
-    printf("\n");
-    print_tanker(tanker_id, "Starting to unload fuel into the station... ⛽️");
+    LOG_PRINTF(LOG_LEVEL_EVENTS, "\n");
+    LOG_TANKER(tanker_id, "Starting to unload fuel into the station... ⛽️");
+    tanker_data->start_unloading_time = time(NULL);
 
     while (total_fuel_left > 0)
     {
-        int fuel_per_time = (total_fuel_left < fuel_per_time_default) ? total_fuel_left : fuel_per_time_default;
+        int64_t fuel_per_time = (total_fuel_left < fuel_per_time_default) ? total_fuel_left : fuel_per_time_default;
         pthread_mutex_lock(&dynamic_lock); // 🔒
         gas_station_fuel_storage += fuel_per_time;
         total_fuel_left -= fuel_per_time;
         tanker_data->total_fuel_deliveries++;
+        fuel_deliveries++;
+        record_event(EVENT_TANKER_UNLOAD, tanker_id, VEHICLE_NOT_FOUND, -1, fuel_per_time, gas_station_fuel_storage);
+        publish_station_snapshot();
 
-        printf("\n");
-        print_tanker(tanker_id, "⏳ Unloading %d liters of fuel into the station...", fuel_per_time);
-        print_tanker(tanker_id, "🛢️  Fuel unloaded successfully. Station storage now holds: %d liters.", gas_station_fuel_storage);
+        LOG_PRINTF(LOG_LEVEL_EVENTS, "\n");
+        LOG_TANKER(tanker_id, "⏳ Unloading %" PRId64 " liters of fuel into the station...", fuel_per_time);
+        LOG_TANKER(tanker_id, "🛢️  Fuel unloaded successfully. Station storage now holds: %" PRId64 " liters.", gas_station_fuel_storage);
 
         if (total_fuel_left == 0)
         {
-            print_tanker(tanker_id, "Tanker is empty...");
-            print_tanker(tanker_id, "Tanker is leaving the station...");
+            LOG_TANKER(tanker_id, "Tanker is empty...");
+            LOG_TANKER(tanker_id, "Tanker is leaving the station...");
         }
         else
         {
-            print_tanker(tanker_id, "🚚 Remaining fuel in tanker: %d liters.", total_fuel_left);
-            print_tanker(tanker_id, "✅ Fuel available and ready for consumption, preparing for next delivery...");
+            LOG_TANKER(tanker_id, "🚚 Remaining fuel in tanker: %" PRId64 " liters.", total_fuel_left);
+            LOG_TANKER(tanker_id, "✅ Fuel available and ready for consumption, preparing for next delivery...");
         }
 
         // Notify all waiting cars that fuel is available
@@ -112,8 +185,9 @@ void *tanker(void *thread_data)
 
         // Give cars a chance to acquire the mutex, check fuel, and proceed if possible
         // This also shows that tanker is fueling during 1 second
-        sleep(1);
+        sleep(TANKER_UNLOAD_INTERVAL_SEC);
     }
+    tanker_data->end_unloading_time = time(NULL);
     return NULL;
 }
 
@@ -126,22 +200,31 @@ void *car(void *thread_data)
     // int fuel_pump_id = car_data->fuel_pump_id;
     VehicleType vehicle_type = car_data->vehicle_type;
 
+    record_event(EVENT_ARRIVAL, car_id, vehicle_type, -1, car_fuel_required, -1);
+    station_snapshot_add_waiting_for_pump(1);
     sem_wait(&fuel_pump_semaphore);
+    station_snapshot_add_waiting_for_pump(-1);
 
-    printf("\n");
-    print_car(vehicle_type, car_id, "Attempting to get fuel...\n");
+    LOG_PRINTF(LOG_LEVEL_EVENTS, "\n");
+    LOG_CAR(vehicle_type, car_id, "Attempting to get fuel...\n");
 
     car_data->start_waiting_time = time(NULL);
+    uint64_t start_waiting_ns = get_monotonic_ns();
     pthread_mutex_lock(&dynamic_lock); // 🔒
 
     occupy_new_fuel_pump(car_id, vehicle_type, car_data);
+    record_event(EVENT_PUMP_OCCUPY, car_id, vehicle_type, car_data->fuel_pump_id, car_fuel_required, gas_station_fuel_storage);
+    publish_station_snapshot();
 
     int is_time_passed = 0;
+    uint64_t fuel_wait_start_ns = 0;
     if (total_fuel_left + gas_station_fuel_storage < car_fuel_required)
     {
         car_data->end_waiting_time = time(NULL);
         car_data->is_left_without_fuel = true;
-        print_car(vehicle_type, car_id, "❌ Oh no, not enough fuel. Leaving the station...");
+        car_data->outcome = VEHICLE_OUTCOME_NO_FUEL;
+        record_event(EVENT_NO_FUEL, car_id, vehicle_type, car_data->fuel_pump_id, car_fuel_required, gas_station_fuel_storage);
+        LOG_CAR(vehicle_type, car_id, "❌ Oh no, not enough fuel. Leaving the station...");
     }
     else
     {
@@ -153,7 +236,12 @@ void *car(void *thread_data)
                 break;
             }
 
-            print_car(vehicle_type, car_id, "❌ Not enough fuel, waiting for delivery...");
+            record_event(EVENT_FUEL_WAIT, car_id, vehicle_type, car_data->fuel_pump_id, car_fuel_required, gas_station_fuel_storage);
+            if (fuel_wait_start_ns == 0)
+            {
+                fuel_wait_start_ns = get_monotonic_ns();
+            }
+            LOG_CAR(vehicle_type, car_id, "❌ Not enough fuel, waiting for delivery...");
             if (car_waiting_time > 0)
             {
                 // time_t current_time = time(NULL);
@@ -176,7 +264,10 @@ void *car(void *thread_data)
 
                 // ERROR: pthread_cond_timedwait works wrong, for some reason it skips moment when we already out of waiting time
                 // So, instead just use pthread_cond_wait and check if car can still wait
+                cars_waiting_for_fuel++;
+                publish_station_snapshot();
                 pthread_cond_wait(&dynamic_cond, &dynamic_lock);
+                cars_waiting_for_fuel--;
 
                 int waiting_time = difftime(time(NULL), car_data->start_waiting_time);
                 if (waiting_time >= car_waiting_time)
@@ -187,7 +278,10 @@ void *car(void *thread_data)
             }
             else
             {
+                cars_waiting_for_fuel++;
+                publish_station_snapshot();
                 pthread_cond_wait(&dynamic_cond, &dynamic_lock);
+                cars_waiting_for_fuel--;
             }
 
             if (total_fuel_left + gas_station_fuel_storage < car_fuel_required)
@@ -197,20 +291,27 @@ void *car(void *thread_data)
 
             if (gas_station_fuel_storage >= car_fuel_required)
             {
-                print_car(vehicle_type, car_id, "✅ Fuel is available. Filling up!");
+                LOG_CAR(vehicle_type, car_id, "✅ Fuel is available. Filling up!");
             }
             else
             {
-                printf("\n");
-                print_car(vehicle_type, car_id, "❌ Still not enough fuel, waiting...");
+                LOG_PRINTF(LOG_LEVEL_EVENTS, "\n");
+                LOG_CAR(vehicle_type, car_id, "❌ Still not enough fuel, waiting...");
             }
         }
 
+        if (fuel_wait_start_ns != 0 && car_data->fuel_pump_id >= 0)
+        {
+            fuel_pumps[car_data->fuel_pump_id].fuel_wait_ns += get_monotonic_ns() - fuel_wait_start_ns;
+        }
+
         if (is_time_passed == 1)
         {
             car_data->end_waiting_time = time(NULL);
             car_data->is_left_without_fuel = true;
-            print_car(vehicle_type, car_id, "❌ Time's up (waited %d seconds). Fuel wasn't delivered in time. Leaving the station...", car_waiting_time);
+            car_data->outcome = VEHICLE_OUTCOME_TIMEOUT;
+            record_event(EVENT_TIMEOUT, car_id, vehicle_type, car_data->fuel_pump_id, car_fuel_required, gas_station_fuel_storage);
+            LOG_CAR(vehicle_type, car_id, "❌ Time's up (waited %d seconds). Fuel wasn't delivered in time. Leaving the station...", car_waiting_time);
         }
         else
         {
@@ -218,73 +319,167 @@ void *car(void *thread_data)
             {
                 car_data->end_waiting_time = time(NULL);
                 car_data->is_left_without_fuel = true;
-                print_car(vehicle_type, car_id, "❌ Not enough fuel. Leaving gas station...");
+                car_data->outcome = VEHICLE_OUTCOME_NO_FUEL;
+                record_event(EVENT_NO_FUEL, car_id, vehicle_type, car_data->fuel_pump_id, car_fuel_required, gas_station_fuel_storage);
+                LOG_CAR(vehicle_type, car_id, "❌ Not enough fuel. Leaving gas station...");
             }
             else
             {
                 gas_station_fuel_storage -= car_fuel_required;
                 car_data->end_waiting_time = time(NULL);
-                print_car(vehicle_type, car_id, "✅ Successfully refueled %d liters. Remaining fuel at station: %d liters.", car_fuel_required, gas_station_fuel_storage);
+                if (car_data->fuel_pump_id >= 0)
+                {
+                    fuel_pumps[car_data->fuel_pump_id].vehicles_serviced++;
+                    fuel_pumps[car_data->fuel_pump_id].fuel_dispensed += car_fuel_required;
+                }
+                record_event(EVENT_REFUEL, car_id, vehicle_type, car_data->fuel_pump_id, car_fuel_required, gas_station_fuel_storage);
+                LOG_CAR(vehicle_type, car_id, "✅ Successfully refueled %d liters. Remaining fuel at station: %" PRId64 " liters.", car_fuel_required, gas_station_fuel_storage);
             }
         }
     }
 
-    double waiting_time = difftime(car_data->end_waiting_time, car_data->start_waiting_time);
-    print_car(vehicle_type, car_id, "⏳ Waited for %.2f seconds\n", waiting_time);
+    LOG_CAR(vehicle_type, car_id, "⏳ Waited for %.2f seconds\n", difftime(car_data->end_waiting_time, car_data->start_waiting_time));
+    uint64_t waited_ns = get_monotonic_ns() - start_waiting_ns;
+    car_data->wait_time_ns = waited_ns;
+    publish_station_snapshot();
 
     pthread_mutex_unlock(&dynamic_lock); // 🔓
 
+    // The pump is still ours, so nobody else writes to its shard
+    if (car_data->fuel_pump_id >= 0)
+    {
+        statistics_shard_record(&statistics_shards[car_data->fuel_pump_id], vehicle_type, car_fuel_required, !car_data->is_left_without_fuel, waited_ns);
+    }
+    // Recorded before the pump is released, so the next car on this pump is always traced after it
+    record_event(EVENT_PUMP_FREE, car_id, vehicle_type, car_data->fuel_pump_id, car_fuel_required, -1);
+    // Releasing under the lock also hands the shard over to the next car of this pump
+    pthread_mutex_lock(&dynamic_lock); // 🔒
     free_fuel_pump(car_id, vehicle_type);
+    publish_station_snapshot();
+    pthread_mutex_unlock(&dynamic_lock); // 🔓
     sem_post(&fuel_pump_semaphore);
     return NULL;
 }
 
-int main()
+int main(int argc, char **argv)
 {
+    if (parse_arguments(argc, argv) == 0)
+    {
+        return 1;
+    }
+    // The event stream writes to fd 1 directly, so everything printed moves to stderr to keep it parseable.
+    // glibc lets `stdout` be reassigned; the stream itself still goes to the original standard output.
+    if (events_format != NULL && strcmp(events_path, "-") == 0)
+    {
+        fflush(stdout);
+        stdout = stderr;
+    }
+
     if (init_simulation_data() == 0)
     {
         clean_up_main();
         return 1;
     }
 
+    if (is_estimate_enabled || is_estimate_compared)
+    {
+        if (queue_estimate_compute(scenario, tankers_number, &queue_estimate) == 0)
+        {
+            clean_up_main();
+            return 1;
+        }
+        if (is_estimate_enabled)
+        {
+            queue_estimate_print(&queue_estimate);
+            clean_up_main();
+            return 0;
+        }
+    }
+
+    // Every car is a thread, that is where the simulation stops scaling; the estimate above does not
+    if (scenario->result_vehicles_length > INT_MAX)
+    {
+        printf("❌ Scenario uses %" PRId64 " vehicles, the simulation runs at most %d.\n", scenario->result_vehicles_length, INT_MAX);
+        clean_up_main();
+        return 1;
+    }
+    number_of_cars = (int)scenario->result_vehicles_length;
+
     if (setup_main() == 0)
     {
         clean_up_main();
         return 1;
     }
 
-    printf("🚗 Welcome to the fueling station simulation! 🚗\n");
+    LOG_PRINTF(LOG_LEVEL_EVENTS, "🚗 Welcome to the fueling station simulation! 🚗\n");
 
-    pthread_t car_threads[number_of_cars];
-    Car cars[number_of_cars];
+    // Heap, not stack: a large scenario would overflow the main thread's stack
+    cars_list = (Car *)calloc(number_of_cars, sizeof(Car));
+    car_threads = (pthread_t *)malloc(number_of_cars * sizeof(pthread_t));
+    if (cars_list == NULL || car_threads == NULL)
+    {
+        printf("❌ Failed to allocate memory for %d cars.\n", number_of_cars);
+        clean_up_main();
+        return 1;
+    }
+    Car *cars = cars_list;
 
     pthread_t tanker_threads[tankers_number];
     Tanker tankers[tankers_number];
 
     total_fuel_left = fuel_in_tanker;
+    if (is_live_stats_enabled && live_stats_open(number_of_fuel_pumps, (int64_t)start_time) == 0)
+    {
+        clean_up_main();
+        return 1;
+    }
+    // No other threads yet, so no need for `dynamic_lock`
+    publish_station_snapshot();
+    if (samples_path != NULL && sampler_start(samples_path, samples_format, sample_interval_ms) == 0)
+    {
+        clean_up_main();
+        return 1;
+    }
+    if (metrics_address != NULL && metrics_server_start(metrics_address, statistics_shards, number_of_fuel_pumps) == 0)
+    {
+        clean_up_main();
+        return 1;
+    }
 
-    for (int i = 0; i < number_of_cars; i++)
+    VehicleIterator vehicle_iterator;
+    if (vehicle_iterator_init(&vehicle_iterator, scenario) == 0)
+    {
+        clean_up_main();
+        return 1;
+    }
+    Vehicle current_vehicle;
+    for (int i = 0; i < number_of_cars && vehicle_iterator_next(&vehicle_iterator, &current_vehicle); i++)
     {
-        Vehicle *current_vehicle = read_data_parser_result->json_result->result_vehicles[i];
 
         int car_id = i + 1;
         cars[i].number = car_id;
-        cars[i].waiting_time = current_vehicle->wait_time_sec;
-        cars[i].fuel_required = current_vehicle->fuel_needed;
+        cars[i].waiting_time = current_vehicle.wait_time_sec;
+        cars[i].fuel_required = current_vehicle.fuel_needed;
         cars[i].fuel_pump_id = -1;
         cars[i].is_left_without_fuel = false;
-        cars[i].vehicle_type = current_vehicle->vehicle_type;
+        cars[i].outcome = VEHICLE_OUTCOME_REFUELED;
+        cars[i].wait_time_ns = 0;
+        cars[i].vehicle_type = current_vehicle.vehicle_type;
 
         pthread_attr_t attributes;
         init_attributes_with_min_stack_size(&attributes);
 
         if (pthread_create(&car_threads[i], &attributes, car, (void *)&cars[i]) != 0)
         {
+            // Usually the OS thread limit: simulate the cars that made it and join only those
             printf("❌ Error: pthread_create for car %d\n", car_id);
+            number_of_cars = i;
+            break;
         }
     }
+    vehicle_iterator_close(&vehicle_iterator);
     // Cars arrived first
-    sleep(2);
+    sleep(TANKER_ARRIVAL_DELAY_SEC);
     for (int i = 0; i < tankers_number; i++)
     {
         int tanker_id = i + 1;
@@ -292,6 +487,8 @@ int main()
         tankers[i].number = tanker_id;
         tankers[i].fuel_per_time = fuel_per_time;
         tankers[i].total_fuel_deliveries = 0;
+        tankers[i].start_unloading_time = 0;
+        tankers[i].end_unloading_time = 0;
 
         pthread_attr_t attributes;
         init_attributes_with_min_stack_size(&attributes);
@@ -299,6 +496,8 @@ int main()
         if (pthread_create(&tanker_threads[i], &attributes, tanker, (void *)&tankers[i]) != 0)
         {
             printf("❌ Error: pthread_create for tanker %d\n", tanker_id);
+            tankers_number = i;
+            break;
         }
     }
 
@@ -319,29 +518,337 @@ int main()
         }
     }
 
+    simulation_duration_ns = get_elapsed_ns();
+    sampler_stop();
+    statistics_shards_merge(statistics_shards, number_of_fuel_pumps, vehicle_statistics);
     print_statistics(cars, tankers);
+    if (statistics_path != NULL)
+    {
+        write_statistics_json(cars, tankers);
+    }
+    if (results_path != NULL)
+    {
+        write_results_columns(cars);
+    }
+    if (is_estimate_compared)
+    {
+        print_estimate_comparison();
+    }
     clean_up_main();
     return 0;
 }
 
+void print_usage(char *program_name)
+{
+    printf("Usage: %s [options]\n", program_name);
+    printf("\n");
+    printf("Options:\n");
+    printf("   --trace <file.gst>    Write binary event trace (decode with gas_station_trace).\n");
+    printf("   --chrome-trace <file> Write Chrome trace-event JSON (open in Perfetto).\n");
+    printf("   --events jsonl        Stream events as JSON lines.\n");
+    printf("   --events-file <file>  Where to stream events (default: events.jsonl, \"-\" for stdout, logs then go to stderr).\n");
+    printf("   --statistics <file>   Where to save statistics JSON (default: statistics.json, \"none\" to skip).\n");
+    printf("   --results <file>      Write per-vehicle results as columns (summarize with gas_station_columns).\n");
+    printf("   --samples <file>      Write a time series of storage, queue and pump usage.\n");
+    printf("   --samples-format <f>  csv or json (default: csv).\n");
+    printf("   --sample-interval <ms> Time between samples (default: %d ms).\n", SAMPLER_DEFAULT_INTERVAL_MS);
+    printf("   --metrics <address>   Serve Prometheus metrics on [host:]port (localhost) or unix:<path>.\n");
+    printf("   --live                Publish live statistics in shared memory (watch with gas_station_top).\n");
+    printf("   --scenario <file>     Scenario to run, JSON or compiled with validation --compile (default: data.json).\n");
+    printf("   --max-vehicles <n>    Highest max_vehicle_capacity a JSON scenario may ask for (default: %d).\n", DEFAULT_MAX_VEHICLES);
+    printf("   --max-fuel-pumps <n>  Highest fuel_pumps_count (default: %d).\n", DEFAULT_MAX_FUEL_PUMPS_COUNT);
+    printf("   --max-tanker-fuel <n> Highest initial_fuel_in_tanker (default: %d).\n", DEFAULT_MAX_INITIAL_FUEL_IN_TANKER);
+    printf("   --max-transfer-rate <n> Highest fuel_transfer_rate (default: %d).\n", DEFAULT_MAX_FUEL_TRANSFER_RATE);
+    printf("   --estimate            Print the M/M/c queueing estimate of the scenario without simulating.\n");
+    printf("   --estimate-compare    Simulate, then compare the run with the estimate.\n");
+    printf("   --log-level <level>   off, summary, events or debug (default: events).\n");
+    printf("   --hires-time          Log timestamps with milliseconds (HH:MM:SS.mmm).\n");
+    printf("   --help                Show this message.\n");
+}
+
+int parse_arguments(int argc, char **argv)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--trace") == 0)
+        {
+            if (i + 1 >= argc)
+            {
+                printf("❌ [--trace]: Missing file path.\n");
+                return 0;
+            }
+            trace_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--chrome-trace") == 0)
+        {
+            if (i + 1 >= argc)
+            {
+                printf("❌ [--chrome-trace]: Missing file path.\n");
+                return 0;
+            }
+            chrome_trace_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--events") == 0)
+        {
+            if (i + 1 >= argc)
+            {
+                printf("❌ [--events]: Missing format.\n");
+                return 0;
+            }
+            events_format = argv[++i];
+            if (strcmp(events_format, "jsonl") != 0)
+            {
+                printf("❌ [--events]: Unknown format '%s'. Expected jsonl.\n", events_format);
+                return 0;
+            }
+        }
+        else if (strcmp(argv[i], "--events-file") == 0)
+        {
+            if (i + 1 >= argc)
+            {
+                printf("❌ [--events-file]: Missing file path.\n");
+                return 0;
+            }
+            events_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--statistics") == 0)
+        {
+            if (i + 1 >= argc)
+            {
+                printf("❌ [--statistics]: Missing file path.\n");
+                return 0;
+            }
+            statistics_path = argv[++i];
+            if (strcmp(statistics_path, "none") == 0)
+            {
+                statistics_path = NULL;
+            }
+        }
+        else if (strcmp(argv[i], "--results") == 0)
+        {
+            if (i + 1 >= argc)
+            {
+                printf("❌ [--results]: Missing file path.\n");
+                return 0;
+            }
+            results_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--samples") == 0)
+        {
+            if (i + 1 >= argc)
+            {
+                printf("❌ [--samples]: Missing file path.\n");
+                return 0;
+            }
+            samples_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--samples-format") == 0)
+        {
+            if (i + 1 >= argc)
+            {
+                printf("❌ [--samples-format]: Missing format.\n");
+                return 0;
+            }
+            i++;
+            if (strcmp(argv[i], "csv") == 0)
+            {
+                samples_format = SAMPLES_FORMAT_CSV;
+            }
+            else if (strcmp(argv[i], "json") == 0)
+            {
+                samples_format = SAMPLES_FORMAT_JSON;
+            }
+            else
+            {
+                printf("❌ [--samples-format]: Unknown format '%s'. Expected csv or json.\n", argv[i]);
+                return 0;
+            }
+        }
+        else if (strcmp(argv[i], "--sample-interval") == 0)
+        {
+            if (i + 1 >= argc)
+            {
+                printf("❌ [--sample-interval]: Missing interval.\n");
+                return 0;
+            }
+            sample_interval_ms = atoi(argv[++i]);
+            if (sample_interval_ms <= 0)
+            {
+                printf("❌ [--sample-interval]: Interval must be a positive number of milliseconds.\n");
+                return 0;
+            }
+        }
+        else if (strcmp(argv[i], "--metrics") == 0)
+        {
+            if (i + 1 >= argc)
+            {
+                printf("❌ [--metrics]: Missing address.\n");
+                return 0;
+            }
+            metrics_address = argv[++i];
+        }
+        else if (strcmp(argv[i], "--live") == 0)
+        {
+            is_live_stats_enabled = true;
+        }
+        else if (strcmp(argv[i], "--scenario") == 0)
+        {
+            if (i + 1 >= argc)
+            {
+                printf("❌ [--scenario]: Missing file path.\n");
+                return 0;
+            }
+            scenario_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--estimate") == 0)
+        {
+            is_estimate_enabled = true;
+        }
+        else if (strncmp(argv[i], "--max-", 6) == 0)
+        {
+            int limit_result = parse_scenario_limit_argument(argc, argv, &i);
+            if (limit_result == -1)
+            {
+                return 0;
+            }
+            if (limit_result == 0)
+            {
+                printf("❌ Unknown argument '%s'.\n", argv[i]);
+                print_usage(argv[0]);
+                return 0;
+            }
+        }
+        else if (strcmp(argv[i], "--estimate-compare") == 0)
+        {
+            is_estimate_compared = true;
+        }
+        else if (strcmp(argv[i], "--log-level") == 0)
+        {
+            if (i + 1 >= argc)
+            {
+                printf("❌ [--log-level]: Missing level.\n");
+                return 0;
+            }
+            if (set_log_level(argv[++i]) == 0)
+            {
+                printf("❌ [--log-level]: Unknown level '%s'. Expected off, summary, events or debug.\n", argv[i]);
+                return 0;
+            }
+        }
+        else if (strcmp(argv[i], "--hires-time") == 0)
+        {
+            set_timestamp_high_resolution(true);
+        }
+        else if (strcmp(argv[i], "--help") == 0)
+        {
+            print_usage(argv[0]);
+            return 0;
+        }
+        else
+        {
+            printf("❌ Unknown argument '%s'.\n", argv[i]);
+            print_usage(argv[0]);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+void record_event(EventKind kind, int vehicle_id, VehicleType vehicle_type, int pump_id, int64_t fuel, int64_t storage_after)
+{
+    if (trace_path == NULL && chrome_trace_path == NULL && events_format == NULL)
+    {
+        return;
+    }
+
+    SimulationEvent event;
+    event.timestamp_ns = get_elapsed_ns();
+    event.kind = kind;
+    event.vehicle_id = vehicle_id;
+    event.vehicle_type = vehicle_type;
+    event.pump_id = pump_id;
+    event.fuel = fuel;
+    event.storage_after = storage_after;
+
+    if (trace_path != NULL)
+    {
+        trace_write_event(&event);
+    }
+    if (chrome_trace_path != NULL)
+    {
+        chrome_trace_write_event(&event);
+    }
+    if (events_format != NULL)
+    {
+        event_stream_write_event(&event);
+    }
+}
+
+// Called with `dynamic_lock` held
+void publish_station_snapshot()
+{
+    StationState state;
+    state.fuel_storage = gas_station_fuel_storage;
+    state.fuel_left = total_fuel_left;
+    state.occupied_pumps = fuel_pump_occupied;
+    state.cars_waiting_for_pump = 0;
+    state.cars_waiting_for_fuel = cars_waiting_for_fuel;
+    state.fuel_deliveries = fuel_deliveries;
+    station_snapshot_publish(&state);
+
+    LiveStatistics *live_stats = live_stats_begin_update();
+    if (live_stats == NULL)
+    {
+        return;
+    }
+    live_stats->elapsed_ns = get_elapsed_ns();
+    station_snapshot_read(&live_stats->station);
+    for (int i = 0; i < live_stats->fuel_pumps_count; i++)
+    {
+        live_stats->pumps[i].vehicle_id = fuel_pumps_list[i];
+        live_stats->pumps[i].vehicles_serviced = fuel_pumps[i].vehicles_serviced;
+    }
+    statistics_shards_sum_counts(statistics_shards, number_of_fuel_pumps, live_stats->vehicles_serviced, live_stats->vehicles_left_without_fuel);
+    live_stats_end_update(live_stats);
+}
+
 int read_json()
 {
-    char *path = "data.json";
-    read_data_parser_result = read_data_parser(path, false);
+    if (compiled_scenario_is_file(scenario_path))
+    {
+        compiled_scenario = compiled_scenario_open(scenario_path);
+        if (compiled_scenario == NULL)
+        {
+            return 0;
+        }
+        scenario = &compiled_scenario->json_result;
+        LOG_PRINTF(LOG_LEVEL_EVENTS, "✅ Loaded compiled scenario '%s'.\n", scenario_path);
+        if (LOG_ENABLED(LOG_LEVEL_EVENTS))
+        {
+            print_json_result(scenario);
+        }
+        return 1;
+    }
+
+    read_data_parser_result = read_data_parser(scenario_path, false);
     if (
         read_data_parser_result == NULL                     //
         || read_data_parser_result->json_result == NULL     //
         || read_data_parser_result->status != CORRECT_VALUE //
     )
     {
-        printf("❌ Failed to parse 'data.json' file.\n");
+        printf("❌ Failed to parse '%s' file.\n", scenario_path);
         printf("\n");
         printf("💡 Try running validation command. It will check the file for errors and provide detailed validation results.\n");
         clean_up_read_data_parser_result(&read_data_parser_result);
         return 0;
     }
-    printf("✅ Successfully parsed 'data.json' file.\n");
-    print_json_result(read_data_parser_result->json_result);
+    scenario = read_data_parser_result->json_result;
+    LOG_PRINTF(LOG_LEVEL_EVENTS, "✅ Successfully parsed '%s' file.\n", scenario_path);
+    if (LOG_ENABLED(LOG_LEVEL_EVENTS))
+    {
+        print_json_result(scenario);
+    }
     return 1;
 }
 
@@ -353,10 +860,9 @@ int init_simulation_data()
         return 0;
     }
 
-    number_of_fuel_pumps = read_data_parser_result->json_result->fuel_pumps_count;
-    fuel_per_time = read_data_parser_result->json_result->fuel_transfer_rate;
-    fuel_in_tanker = read_data_parser_result->json_result->initial_fuel_in_tanker;
-    number_of_cars = read_data_parser_result->json_result->result_vehicles_length;
+    number_of_fuel_pumps = scenario->fuel_pumps_count;
+    fuel_per_time = scenario->fuel_transfer_rate;
+    fuel_in_tanker = scenario->initial_fuel_in_tanker;
 
     fuel_pumps_list = (int *)malloc(number_of_fuel_pumps * sizeof(int));
     if (fuel_pumps_list == NULL)
@@ -370,6 +876,13 @@ int init_simulation_data()
         fuel_pumps_list[i] = -1;
     }
 
+    fuel_pumps = (FuelPump *)calloc(number_of_fuel_pumps, sizeof(FuelPump));
+    if (fuel_pumps == NULL)
+    {
+        printf("❌ Failed to allocate memory for fuel pumps statistics.\n");
+        return 0;
+    }
+
     return 1;
 }
 
@@ -407,32 +920,18 @@ int occupy_new_fuel_pump(int car_id, VehicleType vehicle_type, Car *car_data)
     {
         if (fuel_pumps_list[i] == -1)
         {
-            if (vehicle_type == VEHICLE_AUTO)
-            {
-                printf("\n⛽️ Fuel pump #%d occupied by 🚗 #%d: %d/%d pumps now in use.\n\n",
-                       i + 1,
-                       car_id, fuel_pump_occupied, number_of_fuel_pumps);
-            }
-            else if (vehicle_type == VEHICLE_VAN)
-            {
-                printf("\n⛽️ Fuel pump #%d occupied by 🚙 #%d: %d/%d pumps now in use.\n\n",
-                       i + 1,
-                       car_id, fuel_pump_occupied, number_of_fuel_pumps);
-            }
-            else if (vehicle_type == VEHICLE_TRUCK)
-            {
-                printf("\n⛽️ Fuel pump #%d occupied by 🚛 #%d: %d/%d pumps now in use.\n\n",
+            LOG_PRINTF(LOG_LEVEL_EVENTS, "\n⛽️ Fuel pump #%d occupied by %s #%d: %d/%d pumps now in use.\n\n",
                        i + 1,
-                       car_id, fuel_pump_occupied, number_of_fuel_pumps);
-            }
+                       get_vehicle_icon(vehicle_type), car_id, fuel_pump_occupied, number_of_fuel_pumps);
             fuel_pumps_list[i] = car_id;
+            fuel_pumps[i].occupied_since_ns = get_monotonic_ns();
             occupied_fuel_pump = i;
             car_data->fuel_pump_id = i;
             break;
         }
     }
 
-    if (get_number_of_occupied_fuel_pumps() == number_of_fuel_pumps)
+    if (LOG_ENABLED(LOG_LEVEL_EVENTS) && get_number_of_occupied_fuel_pumps() == number_of_fuel_pumps)
     {
         printf("⛽️ All fuel pumps are occupied.\n");
     }
@@ -448,31 +947,17 @@ int free_fuel_pump(int car_id, VehicleType vehicle_type)
     {
         if (fuel_pumps_list[i] == car_id)
         {
-            if (vehicle_type == VEHICLE_AUTO)
-            {
-                printf("⛽️ Fuel pump #%d freed by 🚗 #%d: %d/%d pumps still occupied.\n",
-                       i + 1,
-                       car_id, fuel_pump_occupied, number_of_fuel_pumps);
-            }
-            else if (vehicle_type == VEHICLE_VAN)
-            {
-                printf("⛽️ Fuel pump #%d freed by 🚙 #%d: %d/%d pumps still occupied.\n",
+            LOG_PRINTF(LOG_LEVEL_EVENTS, "⛽️ Fuel pump #%d freed by %s #%d: %d/%d pumps still occupied.\n",
                        i + 1,
-                       car_id, fuel_pump_occupied, number_of_fuel_pumps);
-            }
-            else if (vehicle_type == VEHICLE_TRUCK)
-            {
-                printf("⛽️ Fuel pump #%d freed by 🚛 #%d: %d/%d pumps still occupied.\n",
-                       i + 1,
-                       car_id, fuel_pump_occupied, number_of_fuel_pumps);
-            }
+                       get_vehicle_icon(vehicle_type), car_id, fuel_pump_occupied, number_of_fuel_pumps);
             fuel_pumps_list[i] = -1;
+            fuel_pumps[i].busy_ns += get_monotonic_ns() - fuel_pumps[i].occupied_since_ns;
             released_fuel_pump = i;
             break;
         }
     }
 
-    if (get_number_of_free_fuel_pumps() == number_of_fuel_pumps)
+    if (LOG_ENABLED(LOG_LEVEL_EVENTS) && get_number_of_free_fuel_pumps() == number_of_fuel_pumps)
     {
         printf("⛽️ All fuel pumps are free.\n");
     }
@@ -482,17 +967,11 @@ int free_fuel_pump(int car_id, VehicleType vehicle_type)
 
 void print_car_statistics(Car *cars)
 {
-    double total_waiting_time = 0;
-    double total_fuel = 0;
-    int unserviced_vehicles = 0;
-    int serviced_vehicles = 0;
-    for (int i = 0; i < number_of_cars; i++)
+    for (int i = 0; LOG_ENABLED(LOG_LEVEL_EVENTS) && i < number_of_cars; i++)
     {
         double waiting_time = difftime(cars[i].end_waiting_time, cars[i].start_waiting_time);
         if (cars[i].is_left_without_fuel)
         {
-            unserviced_vehicles++;
-
             printf("Car #%d: \n", cars[i].number);
             printf("   ├─ ❌ Left without fuel.\n");
             if (cars[i].fuel_pump_id != -1)
@@ -504,8 +983,6 @@ void print_car_statistics(Car *cars)
         }
         else
         {
-            serviced_vehicles++;
-
             printf("Car #%d: \n", cars[i].number);
             printf("   ├─ ✅ Refueled %d liters.\n", cars[i].fuel_required);
             if (cars[i].fuel_pump_id != -1)
@@ -515,81 +992,300 @@ void print_car_statistics(Car *cars)
             printf("   └─ ⏳ Waited %.2f seconds.\n", waiting_time);
             printf("\n");
         }
-
-        total_waiting_time += waiting_time;
-        total_fuel += cars[i].fuel_required;
     }
-    double average_waiting_time = total_waiting_time / number_of_cars;
-    double average_fuel = total_fuel / number_of_cars;
+
+    VehicleStatistics total;
+    get_total_vehicle_statistics(&total);
+    double average_waiting_time = number_of_cars > 0 ? total.wait_time_ns / 1e9 / number_of_cars : 0;
+    double average_fuel = number_of_cars > 0 ? (double)total.fuel_required / number_of_cars : 0;
     printf("\n");
-    printf("🚗 Total cars serviced: %d\n", serviced_vehicles);
-    printf("🚗 Total cars left without fuel: %d\n", unserviced_vehicles);
+    printf("🚗 Total cars serviced: %" PRId64 "\n", total.serviced);
+    printf("🚗 Total cars left without fuel: %" PRId64 "\n", total.unserviced);
     printf("\n");
     printf("⏳ Average car waiting time: %.2f seconds\n", average_waiting_time);
     printf("🛢️  The average fuel per car is: %.2f liters.\n", average_fuel);
     printf("\n");
+    print_wait_time_statistics(&total);
 }
 
-void print_fuel_pumps_statistics(Car *cars)
+void get_total_vehicle_statistics(VehicleStatistics *result)
 {
-    printf("\n");
-    int fuel_pumps_vehicles[number_of_fuel_pumps];
-    int fuel_pumps_liters[number_of_fuel_pumps];
-    for (int i = 0; i < number_of_fuel_pumps; fuel_pumps_vehicles[i] = 0, fuel_pumps_liters[i] = 0, i++)
-        ;
+    vehicle_statistics_init(result);
+    for (int i = 0; i < VEHICLE_NOT_FOUND; i++)
+    {
+        vehicle_statistics_merge(result, &vehicle_statistics[i]);
+    }
+}
 
-    for (int i = 0; i < number_of_cars; i++)
+static void print_wait_time_line(const char *prefix, const char *name, const Histogram *histogram)
+{
+    printf("%s %-6s %5" PRIu64 " cars, mean %.3f ± %.3f, p50 %.3f, p95 %.3f, p99 %.3f, max %.3f\n",
+           prefix, name, histogram->count,
+           histogram->mean / 1e6, histogram_get_stddev(histogram) / 1e6,
+           histogram_get_percentile(histogram, 50) / 1e6,
+           histogram_get_percentile(histogram, 95) / 1e6,
+           histogram_get_percentile(histogram, 99) / 1e6,
+           histogram->max / 1e6);
+}
+
+void print_wait_time_statistics(const VehicleStatistics *total)
+{
+    const VehicleType vehicle_types[] = {VEHICLE_AUTO, VEHICLE_TRUCK, VEHICLE_VAN};
+
+    printf("⏳ Wait time per vehicle type (seconds):\n");
+    for (size_t i = 0; i < sizeof(vehicle_types) / sizeof(vehicle_types[0]); i++)
     {
-        if (cars[i].fuel_pump_id != -1 && !cars[i].is_left_without_fuel)
-        {
-            fuel_pumps_vehicles[cars[i].fuel_pump_id]++;
-            fuel_pumps_liters[cars[i].fuel_pump_id] += cars[i].fuel_required;
-        }
+        print_wait_time_line("   ├─", get_vehicle_type_name(vehicle_types[i]), &vehicle_statistics[vehicle_types[i]].wait_time);
     }
+    print_wait_time_line("   └─", "all", &total->wait_time);
+    printf("\n");
+}
+
+void print_fuel_pumps_statistics()
+{
+    printf("\n");
+    double duration = simulation_duration_ns / 1e9;
     for (int i = 0; i < number_of_fuel_pumps; i++)
     {
-        printf("⛽️ Fuel pump #%d: \n", cars[i].number);
-        printf("   ├─ ✅ Successfully serviced %d vehicles.\n", fuel_pumps_vehicles[i]);
-        printf("   └─ 🛢️  Total fueled %d liters.\n", fuel_pumps_liters[i]);
+        const FuelPump *fuel_pump = &fuel_pumps[i];
+        double busy_time = fuel_pump->busy_ns / 1e9;
+        double fuel_wait_time = fuel_pump->fuel_wait_ns / 1e9;
+        printf("⛽️ Fuel pump #%d: \n", i + 1);
+        printf("   ├─ ✅ Successfully serviced %d vehicles.\n", fuel_pump->vehicles_serviced);
+        printf("   ├─ 🛢️  Total fueled %" PRId64 " liters.\n", fuel_pump->fuel_dispensed);
+        printf("   ├─ ⏳ Busy %.2f seconds, idle %.2f seconds (%.1f%% utilization).\n",
+               busy_time, duration > busy_time ? duration - busy_time : 0, duration > 0 ? 100.0 * busy_time / duration : 0);
+        printf("   └─ ⛽️ Occupied time: %.2f seconds waiting for fuel, %.2f seconds dispensing.\n",
+               fuel_wait_time, busy_time > fuel_wait_time ? busy_time - fuel_wait_time : 0);
         printf("\n");
     }
 }
 
+// Run-level measurements matching what the M/M/c estimate predicts
+int print_estimate_comparison()
+{
+    VehicleStatistics total;
+    get_total_vehicle_statistics(&total);
+
+    SimulatedRun simulated;
+    simulated.duration_sec = simulation_duration_ns / 1e9;
+    uint64_t busy_ns = 0;
+    for (int i = 0; i < number_of_fuel_pumps; i++)
+    {
+        busy_ns += fuel_pumps[i].busy_ns;
+    }
+    simulated.utilization = simulation_duration_ns > 0 ? (double)busy_ns / number_of_fuel_pumps / simulation_duration_ns : 0;
+    simulated.mean_service_time_sec = total.wait_time.mean / 1e6;
+    simulated.throughput = simulated.duration_sec > 0 ? total.serviced / simulated.duration_sec : 0;
+    simulated.starvation_probability = number_of_cars > 0 ? (double)total.unserviced / number_of_cars : 0;
+    return queue_estimate_compare(&queue_estimate, &simulated);
+}
+
 void print_tanker_statistics(Tanker *tankers)
 {
-    int all_tankers_fuel = 0;
+    int64_t all_tankers_fuel = 0;
     int all_fuel_deliveries = 0;
-    int all_fuel_per_time = 0;
+    int64_t all_fuel_per_time = 0;
     for (int i = 0; i < tankers_number; i++)
     {
-        int current_fuel_total = tankers[i].fuel_total;
+        int64_t current_fuel_total = tankers[i].fuel_total;
         all_tankers_fuel += current_fuel_total;
 
         int current_fuel_deliveries = tankers[i].total_fuel_deliveries;
         all_fuel_deliveries += current_fuel_deliveries;
 
-        int current_fuel_per_time = tankers[i].fuel_per_time;
+        int64_t current_fuel_per_time = tankers[i].fuel_per_time;
         all_fuel_per_time += current_fuel_per_time;
     }
-    printf("🔥 Total fuel consumed: %d liters\n", all_tankers_fuel - gas_station_fuel_storage);
-    printf("🛢️  Fuel left in storage: %d liters\n", gas_station_fuel_storage);
-    printf("🚚 Total fuel deliveries: %d (<= %d liters each)\n", all_fuel_deliveries, fuel_per_time);
+    printf("🔥 Total fuel consumed: %" PRId64 " liters\n", all_tankers_fuel - gas_station_fuel_storage);
+    printf("🛢️  Fuel left in storage: %" PRId64 " liters\n", gas_station_fuel_storage);
+    printf("🚚 Total fuel deliveries: %d (<= %" PRId64 " liters each)\n", all_fuel_deliveries, fuel_per_time);
 }
 
 void print_statistics(Car *cars, Tanker *tankers)
 {
+    if (!LOG_ENABLED(LOG_LEVEL_SUMMARY))
+    {
+        return;
+    }
     printf("\n");
     printf("📊 STATISTICS:\n");
     printf("\n");
     print_car_statistics(cars);
     print_tanker_statistics(tankers);
-    print_fuel_pumps_statistics(cars);
+    print_fuel_pumps_statistics();
     printf("\n");
 }
 
+static void write_wait_time_percentiles(JsonWriter *json_writer, const Histogram *histogram)
+{
+    json_writer_write_double(json_writer, "wait_time_stddev_sec", histogram_get_stddev(histogram) / 1e6);
+    json_writer_write_double(json_writer, "wait_time_p50_sec", histogram_get_percentile(histogram, 50) / 1e6);
+    json_writer_write_double(json_writer, "wait_time_p95_sec", histogram_get_percentile(histogram, 95) / 1e6);
+    json_writer_write_double(json_writer, "wait_time_p99_sec", histogram_get_percentile(histogram, 99) / 1e6);
+    json_writer_write_double(json_writer, "max_wait_time_sec", histogram->max / 1e6);
+}
+
+// Streams statistics.json in the schema from description_en.txt.
+// Totals come from the merged [vehicle_statistics], only [stats_per_vehicle] walks over [cars].
+int write_statistics_json(Car *cars, Tanker *tankers)
+{
+    const VehicleType vehicle_types[] = {VEHICLE_AUTO, VEHICLE_TRUCK, VEHICLE_VAN};
+    const int vehicle_types_count = sizeof(vehicle_types) / sizeof(vehicle_types[0]);
+
+    VehicleStatistics total;
+    get_total_vehicle_statistics(&total);
+
+    int64_t total_refuels = 0;
+    double total_refuel_time = 0;
+    for (int i = 0; i < tankers_number; i++)
+    {
+        total_refuels += tankers[i].total_fuel_deliveries;
+        total_refuel_time += difftime(tankers[i].end_unloading_time, tankers[i].start_unloading_time);
+    }
+
+    JsonWriter *json_writer = json_writer_open(statistics_path);
+    if (json_writer == NULL)
+    {
+        printf("❌ Failed to open '%s' for statistics.\n", statistics_path);
+        return 0;
+    }
+
+    json_writer_begin_object(json_writer, NULL);
+
+    json_writer_begin_object(json_writer, "gas_station_stats");
+    json_writer_write_int(json_writer, "total_fuel_consumed", total.fuel_consumed);
+    json_writer_write_int(json_writer, "total_serviced_vehicles", total.serviced);
+    json_writer_write_int(json_writer, "remaining_fuel_in_storage", gas_station_fuel_storage);
+    json_writer_write_double(json_writer, "total_simulation_time_sec", simulation_duration_ns / 1e9);
+    json_writer_end_object(json_writer);
+
+    json_writer_begin_object(json_writer, "vehicles_stats");
+    json_writer_write_int(json_writer, "total_vehicles_in_queue", number_of_cars);
+    json_writer_write_double(json_writer, "average_wait_time_sec", number_of_cars > 0 ? total.wait_time_ns / 1e9 / number_of_cars : 0);
+    json_writer_write_double(json_writer, "average_fuel_required_per_vehicle", number_of_cars > 0 ? (double)total.fuel_required / number_of_cars : 0);
+    json_writer_write_double(json_writer, "average_fuel_consumed_per_vehicle", number_of_cars > 0 ? (double)total.fuel_consumed / number_of_cars : 0);
+    write_wait_time_percentiles(json_writer, &total.wait_time);
+
+    json_writer_begin_array(json_writer, "stats_per_vehicle_type");
+    for (int i = 0; i < vehicle_types_count; i++)
+    {
+        const VehicleStatistics *statistics = &vehicle_statistics[vehicle_types[i]];
+        json_writer_begin_object(json_writer, NULL);
+        json_writer_write_string(json_writer, "vehicle_type", get_vehicle_type_name(vehicle_types[i]));
+        json_writer_write_int(json_writer, "total_serviced_cars", statistics->serviced);
+        json_writer_write_int(json_writer, "total_fuel_consumed_by_all_cars", statistics->fuel_consumed);
+        json_writer_write_int(json_writer, "total_fuel_required_by_all_cars", statistics->fuel_required);
+        json_writer_write_double(json_writer, "total_wait_time_sec", statistics->wait_time_ns / 1e9);
+        write_wait_time_percentiles(json_writer, &statistics->wait_time);
+        json_writer_end_object(json_writer);
+    }
+    json_writer_end_array(json_writer);
+
+    json_writer_begin_array(json_writer, "stats_per_vehicle");
+    for (int i = 0; i < number_of_cars; i++)
+    {
+        json_writer_begin_object(json_writer, NULL);
+        json_writer_write_string(json_writer, "vehicle_type", get_vehicle_type_name(cars[i].vehicle_type));
+        json_writer_write_int(json_writer, "fuel_required", cars[i].fuel_required);
+        json_writer_write_int(json_writer, "fuel_received", cars[i].is_left_without_fuel ? 0 : cars[i].fuel_required);
+        json_writer_write_double(json_writer, "wait_time_sec", difftime(cars[i].end_waiting_time, cars[i].start_waiting_time));
+        json_writer_end_object(json_writer);
+    }
+    json_writer_end_array(json_writer);
+    json_writer_end_object(json_writer);
+
+    json_writer_begin_object(json_writer, "tanker_stats");
+    json_writer_write_int(json_writer, "total_refuels", total_refuels);
+    json_writer_write_int(json_writer, "fuel_per_refuel", fuel_per_time);
+    json_writer_write_double(json_writer, "total_refuel_time_sec", total_refuel_time);
+    json_writer_end_object(json_writer);
+
+    json_writer_begin_array(json_writer, "fuel_pump_stats");
+    for (int i = 0; i < number_of_fuel_pumps; i++)
+    {
+        const FuelPump *fuel_pump = &fuel_pumps[i];
+        uint64_t idle_ns = simulation_duration_ns > fuel_pump->busy_ns ? simulation_duration_ns - fuel_pump->busy_ns : 0;
+        uint64_t dispensing_ns = fuel_pump->busy_ns > fuel_pump->fuel_wait_ns ? fuel_pump->busy_ns - fuel_pump->fuel_wait_ns : 0;
+        json_writer_begin_object(json_writer, NULL);
+        json_writer_write_int(json_writer, "fuel_pump", i + 1);
+        json_writer_write_int(json_writer, "total_serviced_cars", fuel_pump->vehicles_serviced);
+        json_writer_write_int(json_writer, "total_fuel_dispensed", fuel_pump->fuel_dispensed);
+        json_writer_write_double(json_writer, "busy_time_sec", fuel_pump->busy_ns / 1e9);
+        json_writer_write_double(json_writer, "idle_time_sec", idle_ns / 1e9);
+        json_writer_write_double(json_writer, "utilization_percent", simulation_duration_ns > 0 ? 100.0 * fuel_pump->busy_ns / simulation_duration_ns : 0);
+        json_writer_write_double(json_writer, "fuel_wait_time_sec", fuel_pump->fuel_wait_ns / 1e9);
+        json_writer_write_double(json_writer, "dispensing_time_sec", dispensing_ns / 1e9);
+        json_writer_end_object(json_writer);
+    }
+    json_writer_end_array(json_writer);
+
+    json_writer_end_object(json_writer);
+
+    if (json_writer_close(&json_writer) == 0)
+    {
+        printf("❌ Failed to write statistics to '%s'.\n", statistics_path);
+        return 0;
+    }
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "💾 Statistics saved to '%s'.\n", statistics_path);
+    return 1;
+}
+
+int write_results_columns(Car *cars)
+{
+    ColumnarWriter *writer = columnar_writer_open(results_path, number_of_cars, (int64_t)start_time);
+    if (writer == NULL)
+    {
+        printf("❌ Failed to open '%s' for results.\n", results_path);
+        return 0;
+    }
+    for (int i = 0; i < number_of_cars; i++)
+    {
+        VehicleResult result;
+        result.vehicle_id = (uint32_t)cars[i].number;
+        result.vehicle_type = cars[i].vehicle_type;
+        result.fuel_required = cars[i].fuel_required;
+        result.fuel_received = cars[i].is_left_without_fuel ? 0 : cars[i].fuel_required;
+        result.wait_ns = cars[i].wait_time_ns;
+        result.pump_id = (int16_t)cars[i].fuel_pump_id;
+        result.outcome = cars[i].outcome;
+        columnar_writer_set_row(writer, i, &result);
+    }
+    if (columnar_writer_close(&writer) == 0)
+    {
+        printf("❌ Failed to write results to '%s'.\n", results_path);
+        return 0;
+    }
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "💾 Results saved to '%s'.\n", results_path);
+    return 1;
+}
+
 int setup_main()
 {
     start_time = time(NULL);
+    start_monotonic_ns = get_monotonic_ns();
+    statistics_shards = statistics_shards_create(number_of_fuel_pumps);
+    if (statistics_shards == NULL)
+    {
+        return 0;
+    }
+    for (int i = 0; i < VEHICLE_NOT_FOUND; i++)
+    {
+        vehicle_statistics_init(&vehicle_statistics[i]);
+    }
+
+    if (trace_path != NULL && trace_open(trace_path) == 0)
+    {
+        return 0;
+    }
+    if (chrome_trace_path != NULL && chrome_trace_open(chrome_trace_path, number_of_fuel_pumps) == 0)
+    {
+        return 0;
+    }
+    if (events_format != NULL && event_stream_open(events_path) == 0)
+    {
+        return 0;
+    }
 
     if (pthread_mutex_init(&dynamic_lock, NULL) != 0)
     {
@@ -607,16 +1303,14 @@ int setup_main()
         return 0;
     }
 
-#ifdef DEBUG_
-    print_thread_stack_size_info();
-    print_max_number_of_threads();
-    print_cpu_info();
-    print_ram_info();
-#endif
-
-#ifdef DEBUG_
-    printf("\n");
-#endif
+    if (LOG_ENABLED(LOG_LEVEL_DEBUG))
+    {
+        print_thread_stack_size_info();
+        print_max_number_of_threads();
+        print_cpu_info();
+        print_ram_info();
+        printf("\n");
+    }
 
     return 1;
 }
@@ -637,14 +1331,34 @@ void clean_up_main()
     }
 
     clean_up_read_data_parser_result(&read_data_parser_result);
+    compiled_scenario_close(&compiled_scenario);
+    scenario = NULL;
+
+    sampler_stop();
+    metrics_server_stop();
+    live_stats_close();
+    trace_close();
+    chrome_trace_close();
+    event_stream_close();
 
     if (fuel_pumps_list != NULL)
     {
         free(fuel_pumps_list);
         fuel_pumps_list = NULL;
     }
+    if (fuel_pumps != NULL)
+    {
+        free(fuel_pumps);
+        fuel_pumps = NULL;
+    }
+    free(cars_list);
+    cars_list = NULL;
+    free(car_threads);
+    car_threads = NULL;
+    statistics_shards_free(&statistics_shards);
 
-#ifdef DEBUG_
-    print_total_simulation_time();
-#endif
+    if (LOG_ENABLED(LOG_LEVEL_DEBUG))
+    {
+        print_total_simulation_time();
+    }
 }
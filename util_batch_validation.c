@@ -0,0 +1,399 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <glob.h>
+#include <dirent.h>
+#include <time.h>
+#include <unistd.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sys/stat.h>
+
+#include "util_batch_validation.h"
+#include "util_json_writer.h"
+
+#define BATCH_INITIAL_CAPACITY 64
+
+typedef struct
+{
+    BatchValidation *batch;
+    atomic_int next_file;
+} BatchContext;
+
+static uint64_t get_time_ns()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+BatchValidation *batch_validation_create()
+{
+    BatchValidation *batch = (BatchValidation *)calloc(1, sizeof(BatchValidation));
+    if (batch == NULL)
+    {
+        printf("❌ Unable to allocate memory for batch validation.\n");
+    }
+    return batch;
+}
+
+static int add_file(BatchValidation *batch, const char *path, _Bool is_found)
+{
+    if (batch->files_count == batch->files_capacity)
+    {
+        int capacity = batch->files_capacity == 0 ? BATCH_INITIAL_CAPACITY : batch->files_capacity * 2;
+        BatchFileResult *temp = (BatchFileResult *)realloc(batch->files, capacity * sizeof(BatchFileResult));
+        if (temp == NULL)
+        {
+            printf("❌ Unable to allocate memory for batch files.\n");
+            return 0;
+        }
+        batch->files = temp;
+        batch->files_capacity = capacity;
+    }
+    BatchFileResult *file = &batch->files[batch->files_count];
+    memset(file, 0, sizeof(BatchFileResult));
+    file->path = strdup(path);
+    if (file->path == NULL)
+    {
+        printf("❌ Unable to allocate memory for batch file path.\n");
+        return 0;
+    }
+    file->is_found = is_found;
+    file->status = NOT_FOUND;
+    batch->files_count++;
+    return 1;
+}
+
+static int is_json_file_name(const char *name)
+{
+    size_t length = strlen(name);
+    return length > 5 && strcmp(name + length - 5, ".json") == 0;
+}
+
+// Sorted, so the same directory always gives the same table
+static int add_directory(BatchValidation *batch, const char *directory)
+{
+    struct dirent **entries = NULL;
+    int entries_count = scandir(directory, &entries, NULL, alphasort);
+    if (entries_count < 0)
+    {
+        printf("❌ Unable to read directory '%s': %s\n", directory, strerror(errno));
+        return 0;
+    }
+
+    int result = 1;
+    size_t directory_length = strlen(directory);
+    _Bool has_separator = directory_length > 0 && directory[directory_length - 1] == '/';
+    for (int i = 0; i < entries_count; i++)
+    {
+        const char *name = entries[i]->d_name;
+        // Also skips "." and ".."
+        if (result == 0 || name[0] == '.')
+        {
+            free(entries[i]);
+            continue;
+        }
+        size_t child_length = directory_length + strlen(name) + 2;
+        char *child = (char *)malloc(child_length * sizeof(char));
+        if (child == NULL)
+        {
+            printf("❌ Unable to allocate memory for batch file path.\n");
+            result = 0;
+            free(entries[i]);
+            continue;
+        }
+        snprintf(child, child_length, has_separator ? "%s%s" : "%s/%s", directory, name);
+
+        // Symlinked files are followed, symlinked directories are not: `up -> ..` would recurse forever
+        struct stat child_stat;
+        _Bool is_found = lstat(child, &child_stat) == 0;
+        _Bool is_link = is_found && S_ISLNK(child_stat.st_mode);
+        if (is_link)
+        {
+            is_found = stat(child, &child_stat) == 0;
+        }
+        if (is_found && S_ISDIR(child_stat.st_mode) && !is_link)
+        {
+            result = add_directory(batch, child);
+        }
+        else if (is_found && S_ISREG(child_stat.st_mode) && is_json_file_name(name))
+        {
+            result = add_file(batch, child, true);
+        }
+        free(child);
+        free(entries[i]);
+    }
+    free(entries);
+    return result;
+}
+
+static int add_path(BatchValidation *batch, const char *path)
+{
+    struct stat path_stat;
+    if (stat(path, &path_stat) != 0)
+    {
+        return add_file(batch, path, false);
+    }
+    if (S_ISDIR(path_stat.st_mode))
+    {
+        return add_directory(batch, path);
+    }
+    // Explicit paths are validated whatever their extension, pipes included
+    return add_file(batch, path, true);
+}
+
+int batch_validation_add_input(BatchValidation *batch, const char *input)
+{
+    if (strpbrk(input, "*?[") == NULL)
+    {
+        return add_path(batch, input);
+    }
+
+    glob_t matches;
+    int glob_result = glob(input, 0, NULL, &matches);
+    if (glob_result == GLOB_NOMATCH)
+    {
+        return add_file(batch, input, false);
+    }
+    if (glob_result != 0)
+    {
+        printf("❌ Unable to expand '%s'.\n", input);
+        globfree(&matches);
+        return 0;
+    }
+    int result = 1;
+    for (size_t i = 0; i < matches.gl_pathc && result; i++)
+    {
+        result = add_path(batch, matches.gl_pathv[i]);
+    }
+    globfree(&matches);
+    return result;
+}
+
+static void validate_file(BatchFileResult *file)
+{
+    if (!file->is_found)
+    {
+        snprintf(file->reason, BATCH_REASON_LENGTH, "File was NOT found.");
+        return;
+    }
+
+    // Messages are captured so they do not mix with the table or --results -, the reason comes from the result
+    char *output = NULL;
+    size_t output_size = 0;
+    FILE *output_stream = open_memstream(&output, &output_size);
+    if (output_stream == NULL)
+    {
+        file->status = ALLOCATION_ERROR;
+        snprintf(file->reason, BATCH_REASON_LENGTH, "Unable to capture parser output.");
+        return;
+    }
+    set_read_data_parser_output(output_stream);
+
+    uint64_t start_ns = get_time_ns();
+    ReadDataParserResult *read_data_parser_result = read_data_parser(file->path, false);
+    file->duration_ns = get_time_ns() - start_ns;
+
+    if (read_data_parser_result == NULL || read_data_parser_result->json_result == NULL)
+    {
+        file->status = read_data_parser_result == NULL ? ALLOCATION_ERROR : read_data_parser_result->status;
+        if (read_data_parser_result == NULL)
+        {
+            snprintf(file->reason, BATCH_REASON_LENGTH, "Unable to allocate memory for the parser result.");
+        }
+        if (file->status == CORRECT_VALUE)
+        {
+            file->status = UNKNOWN_ERROR;
+        }
+    }
+    else
+    {
+        file->status = read_data_parser_result->status;
+        if (file->status == CORRECT_VALUE)
+        {
+            file->vehicles_count = read_data_parser_result->json_result->result_vehicles_length;
+            file->fuel_pumps_count = read_data_parser_result->json_result->fuel_pumps_count;
+        }
+    }
+    if (read_data_parser_result != NULL && file->status != CORRECT_VALUE)
+    {
+        memcpy(file->reason, read_data_parser_result->error, BATCH_REASON_LENGTH);
+    }
+    // Clean up still writes to the captured stream
+    clean_up_read_data_parser_result(&read_data_parser_result);
+    set_read_data_parser_output(NULL);
+    fclose(output_stream);
+    free(output);
+}
+
+static void *batch_worker(void *thread_data)
+{
+    BatchContext *context = (BatchContext *)thread_data;
+    while (true)
+    {
+        int index = atomic_fetch_add_explicit(&context->next_file, 1, memory_order_relaxed);
+        if (index >= context->batch->files_count)
+        {
+            break;
+        }
+        validate_file(&context->batch->files[index]);
+    }
+    return NULL;
+}
+
+int batch_validation_run(BatchValidation *batch, int jobs)
+{
+    if (jobs <= 0)
+    {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        jobs = cpus > 0 ? (int)cpus : 1;
+    }
+    if (jobs > batch->files_count)
+    {
+        jobs = batch->files_count > 0 ? batch->files_count : 1;
+    }
+
+    pthread_t *workers = (pthread_t *)malloc(jobs * sizeof(pthread_t));
+    if (workers == NULL)
+    {
+        printf("❌ Unable to allocate memory for batch workers.\n");
+        return 0;
+    }
+    BatchContext context;
+    context.batch = batch;
+    atomic_init(&context.next_file, 0);
+
+    uint64_t start_ns = get_time_ns();
+    int started = 0;
+    for (; started < jobs; started++)
+    {
+        if (pthread_create(&workers[started], NULL, batch_worker, (void *)&context) != 0)
+        {
+            printf("❌ Error: pthread_create for batch worker %d\n", started);
+            break;
+        }
+    }
+    // Without any worker the files are validated here, so the batch still finishes
+    if (started == 0)
+    {
+        batch_worker((void *)&context);
+    }
+    for (int i = 0; i < started; i++)
+    {
+        pthread_join(workers[i], NULL);
+    }
+    batch->duration_ns = get_time_ns() - start_ns;
+    batch->jobs = started > 0 ? started : 1;
+    free(workers);
+
+    batch->valid_count = 0;
+    for (int i = 0; i < batch->files_count; i++)
+    {
+        if (batch->files[i].status == CORRECT_VALUE)
+        {
+            batch->valid_count++;
+        }
+    }
+    return 1;
+}
+
+void batch_validation_print(const BatchValidation *batch)
+{
+    printf("%-2s %-28s %12s %6s %10s  %s\n", "", "STATUS", "VEHICLES", "PUMPS", "TIME ms", "FILE");
+    for (int i = 0; i < batch->files_count; i++)
+    {
+        const BatchFileResult *file = &batch->files[i];
+        if (file->status == CORRECT_VALUE)
+        {
+            printf("✅ %-28s %12lld %6d %10.2f  %s\n", get_status_name(file->status), (long long)file->vehicles_count,
+                   file->fuel_pumps_count, (double)file->duration_ns / 1e6, file->path);
+        }
+        else
+        {
+            printf("❌ %-28s %12s %6s %10.2f  %s\n", get_status_name(file->status), "-", "-",
+                   (double)file->duration_ns / 1e6, file->path);
+            if (file->reason[0] != '\0')
+            {
+                printf("   └─ %s\n", file->reason);
+            }
+        }
+    }
+
+    double duration_sec = (double)batch->duration_ns / 1e9;
+    printf("\n");
+    printf("📊 SUMMARY:\n");
+    printf("   ├─ 📄 Files: %d\n", batch->files_count);
+    printf("   ├─ ✅ Valid: %d\n", batch->valid_count);
+    printf("   ├─ ❌ Invalid: %d\n", batch->files_count - batch->valid_count);
+    // Invalid files by status, in StatusType order
+    for (int status = NOT_FOUND; status <= ALLOCATION_ERROR; status++)
+    {
+        if (status == CORRECT_VALUE)
+        {
+            continue;
+        }
+        int count = 0;
+        for (int i = 0; i < batch->files_count; i++)
+        {
+            count += batch->files[i].status == (StatusType)status;
+        }
+        if (count > 0)
+        {
+            printf("   │     • %s: %d\n", get_status_name((StatusType)status), count);
+        }
+    }
+    printf("   └─ ⏳ Took %.3f seconds on %d threads (%.1f files/s).\n", duration_sec, batch->jobs,
+           duration_sec > 0 ? batch->files_count / duration_sec : 0.0);
+}
+
+int batch_validation_write_json(const BatchValidation *batch, const char *path)
+{
+    JsonWriter *json_writer = json_writer_open(path);
+    if (json_writer == NULL)
+    {
+        return 0;
+    }
+    json_writer_begin_object(json_writer, NULL);
+    json_writer_begin_object(json_writer, "summary");
+    json_writer_write_int(json_writer, "files", batch->files_count);
+    json_writer_write_int(json_writer, "valid", batch->valid_count);
+    json_writer_write_int(json_writer, "invalid", batch->files_count - batch->valid_count);
+    json_writer_write_int(json_writer, "jobs", batch->jobs);
+    json_writer_write_double(json_writer, "duration_sec", (double)batch->duration_ns / 1e9);
+    json_writer_end_object(json_writer);
+
+    json_writer_begin_array(json_writer, "files");
+    for (int i = 0; i < batch->files_count; i++)
+    {
+        const BatchFileResult *file = &batch->files[i];
+        json_writer_begin_object(json_writer, NULL);
+        json_writer_write_string(json_writer, "path", file->path);
+        json_writer_write_bool(json_writer, "valid", file->status == CORRECT_VALUE);
+        json_writer_write_string(json_writer, "status", get_status_name(file->status));
+        json_writer_write_int(json_writer, "vehicles", file->vehicles_count);
+        json_writer_write_int(json_writer, "fuel_pumps", file->fuel_pumps_count);
+        json_writer_write_double(json_writer, "duration_ms", (double)file->duration_ns / 1e6);
+        json_writer_write_string(json_writer, "reason", file->reason);
+        json_writer_end_object(json_writer);
+    }
+    json_writer_end_array(json_writer);
+    json_writer_end_object(json_writer);
+    return json_writer_close(&json_writer);
+}
+
+void batch_validation_free(BatchValidation **batch)
+{
+    if ((*batch) == NULL)
+    {
+        return;
+    }
+    for (int i = 0; i < (*batch)->files_count; i++)
+    {
+        free((*batch)->files[i].path);
+    }
+    free((*batch)->files);
+    free((*batch));
+    (*batch) = NULL;
+}
@@ -0,0 +1,46 @@
+#ifndef UTIL_BATCH_VALIDATION_H
+#define UTIL_BATCH_VALIDATION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "util_read_data_parser.h"
+
+// Batch mode (`validation --batch sweep/ 'runs/*.json'`): inputs are files, globs or directories,
+// directories are searched recursively for *.json, without following symlinked directories.
+// Files are validated on a pool of threads, each with its own parser state; parser messages are
+// captured per file instead of printed.
+#define BATCH_REASON_LENGTH READ_DATA_PARSER_ERROR_LENGTH
+
+typedef struct
+{
+    char *path;
+    _Bool is_found;
+    StatusType status;
+    int64_t vehicles_count;
+    int fuel_pumps_count;
+    uint64_t duration_ns;
+    // First error the parser reported, empty for valid files
+    char reason[BATCH_REASON_LENGTH];
+} BatchFileResult;
+
+typedef struct
+{
+    BatchFileResult *files;
+    int files_count;
+    int files_capacity;
+    int valid_count;
+    int jobs;
+    uint64_t duration_ns;
+} BatchValidation;
+
+BatchValidation *batch_validation_create();
+// An input that matches nothing is kept as a missing file, so it shows up in the results
+int batch_validation_add_input(BatchValidation *batch, const char *input);
+// [jobs] <= 0 uses one thread per online CPU
+int batch_validation_run(BatchValidation *batch, int jobs);
+void batch_validation_print(const BatchValidation *batch);
+int batch_validation_write_json(const BatchValidation *batch, const char *path);
+void batch_validation_free(BatchValidation **batch);
+
+#endif
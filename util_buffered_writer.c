@@ -0,0 +1,294 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "util_buffered_writer.h"
+
+static int write_all(int fd, const char *bytes, size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t written = write(fd, bytes, size);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return 0;
+        }
+        bytes += written;
+        size -= (size_t)written;
+    }
+    return 1;
+}
+
+static void *buffered_writer_flusher(void *thread_data)
+{
+    BufferedWriter *writer = (BufferedWriter *)thread_data;
+    pthread_mutex_lock(&writer->flush_lock);
+    while (true)
+    {
+        while (writer->flush_length == 0 && !writer->is_closing)
+        {
+            pthread_cond_wait(&writer->flush_cond, &writer->flush_lock);
+        }
+        if (writer->flush_length == 0)
+        {
+            break;
+        }
+        // The producer does not touch [flush_data] until [flush_length] is back to 0
+        pthread_mutex_unlock(&writer->flush_lock);
+        int write_result = write_all(writer->fd, writer->flush_data, writer->flush_length);
+        pthread_mutex_lock(&writer->flush_lock);
+
+        if (!write_result)
+        {
+            writer->has_flush_error = true;
+        }
+        writer->flush_length = 0;
+        pthread_cond_broadcast(&writer->flush_cond);
+    }
+    pthread_mutex_unlock(&writer->flush_lock);
+    return NULL;
+}
+
+static BufferedWriter *create_buffered_writer(const char *path, size_t capacity)
+{
+    if (path == NULL)
+    {
+        return NULL;
+    }
+    if (capacity == 0)
+    {
+        capacity = BUFFERED_WRITER_DEFAULT_CAPACITY;
+    }
+
+    BufferedWriter *writer = (BufferedWriter *)malloc(sizeof(BufferedWriter));
+    if (writer == NULL)
+    {
+        printf("❌ Unable to allocate memory for buffered writer.\n");
+        return NULL;
+    }
+
+    writer->data = (char *)malloc(capacity * sizeof(char));
+    if (writer->data == NULL)
+    {
+        printf("❌ Unable to allocate memory for buffered writer buffer.\n");
+        free(writer);
+        return NULL;
+    }
+
+    if (strcmp(path, "-") == 0)
+    {
+        writer->fd = STDOUT_FILENO;
+        writer->owns_fd = false;
+    }
+    else
+    {
+        writer->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+        writer->owns_fd = true;
+    }
+    if (writer->fd < 0)
+    {
+        printf("❌ Unable to open '%s' for writing: %s\n", path, strerror(errno));
+        free(writer->data);
+        free(writer);
+        return NULL;
+    }
+
+    writer->length = 0;
+    writer->capacity = capacity;
+    writer->has_error = false;
+    writer->is_async = false;
+    writer->is_closing = false;
+    writer->has_flush_error = false;
+    writer->flush_data = NULL;
+    writer->flush_length = 0;
+    return writer;
+}
+
+BufferedWriter *buffered_writer_open(const char *path, size_t capacity)
+{
+    return create_buffered_writer(path, capacity);
+}
+
+BufferedWriter *buffered_writer_open_async(const char *path, size_t capacity)
+{
+    BufferedWriter *writer = create_buffered_writer(path, capacity);
+    if (writer == NULL)
+    {
+        return NULL;
+    }
+
+    writer->flush_data = (char *)malloc(writer->capacity * sizeof(char));
+    if (writer->flush_data == NULL)
+    {
+        printf("❌ Unable to allocate memory for buffered writer flush buffer.\n");
+        buffered_writer_close(&writer);
+        return NULL;
+    }
+    if (pthread_mutex_init(&writer->flush_lock, NULL) != 0 || pthread_cond_init(&writer->flush_cond, NULL) != 0)
+    {
+        printf("❌ Failed to init buffered writer synchronization.\n");
+        buffered_writer_close(&writer);
+        return NULL;
+    }
+    if (pthread_create(&writer->flusher, NULL, buffered_writer_flusher, (void *)writer) != 0)
+    {
+        printf("❌ Error: pthread_create for buffered writer flusher\n");
+        pthread_mutex_destroy(&writer->flush_lock);
+        pthread_cond_destroy(&writer->flush_cond);
+        buffered_writer_close(&writer);
+        return NULL;
+    }
+    writer->is_async = true;
+    return writer;
+}
+
+// Waits for the flusher to finish the previous buffer, then hands over the current one
+static void hand_over_to_flusher(BufferedWriter *writer)
+{
+    pthread_mutex_lock(&writer->flush_lock);
+    while (writer->flush_length > 0)
+    {
+        pthread_cond_wait(&writer->flush_cond, &writer->flush_lock);
+    }
+    writer->has_error = writer->has_error || writer->has_flush_error;
+    char *temp = writer->flush_data;
+    writer->flush_data = writer->data;
+    writer->flush_length = writer->length;
+    writer->data = temp;
+    writer->length = 0;
+    pthread_cond_broadcast(&writer->flush_cond);
+    pthread_mutex_unlock(&writer->flush_lock);
+}
+
+static void wait_for_flusher(BufferedWriter *writer)
+{
+    pthread_mutex_lock(&writer->flush_lock);
+    while (writer->flush_length > 0)
+    {
+        pthread_cond_wait(&writer->flush_cond, &writer->flush_lock);
+    }
+    writer->has_error = writer->has_error || writer->has_flush_error;
+    pthread_mutex_unlock(&writer->flush_lock);
+}
+
+int buffered_writer_flush(BufferedWriter *writer)
+{
+    if (writer->is_async)
+    {
+        if (writer->length > 0)
+        {
+            hand_over_to_flusher(writer);
+        }
+        wait_for_flusher(writer);
+        return !writer->has_error;
+    }
+
+    if (writer->length == 0)
+    {
+        return !writer->has_error;
+    }
+    if (!write_all(writer->fd, writer->data, writer->length))
+    {
+        writer->has_error = true;
+    }
+    writer->length = 0;
+    return !writer->has_error;
+}
+
+int buffered_writer_write(BufferedWriter *writer, const void *bytes, size_t size)
+{
+    if (writer->length + size > writer->capacity)
+    {
+        if (writer->is_async)
+        {
+            if (writer->length > 0)
+            {
+                hand_over_to_flusher(writer);
+            }
+        }
+        else
+        {
+            buffered_writer_flush(writer);
+        }
+        // Anything bigger than the whole buffer goes straight to the file
+        if (size > writer->capacity)
+        {
+            if (writer->is_async)
+            {
+                wait_for_flusher(writer);
+            }
+            if (!write_all(writer->fd, (const char *)bytes, size))
+            {
+                writer->has_error = true;
+            }
+            return !writer->has_error;
+        }
+    }
+    memcpy(writer->data + writer->length, bytes, size);
+    writer->length += size;
+    return !writer->has_error;
+}
+
+int buffered_writer_close(BufferedWriter **writer)
+{
+    if ((*writer) == NULL)
+    {
+        return 1;
+    }
+    int result = buffered_writer_flush((*writer));
+    if ((*writer)->is_async)
+    {
+        pthread_mutex_lock(&(*writer)->flush_lock);
+        (*writer)->is_closing = true;
+        pthread_cond_broadcast(&(*writer)->flush_cond);
+        pthread_mutex_unlock(&(*writer)->flush_lock);
+
+        pthread_join((*writer)->flusher, NULL);
+        pthread_mutex_destroy(&(*writer)->flush_lock);
+        pthread_cond_destroy(&(*writer)->flush_cond);
+    }
+    if ((*writer)->owns_fd && close((*writer)->fd) != 0)
+    {
+        result = 0;
+    }
+    free((*writer)->flush_data);
+    free((*writer)->data);
+    free((*writer));
+    (*writer) = NULL;
+    return result;
+}
+
+char *format_uint64(char *cursor, uint64_t value)
+{
+    char digits[20];
+    int count = 0;
+    do
+    {
+        digits[count++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+
+    while (count > 0)
+    {
+        *cursor++ = digits[--count];
+    }
+    return cursor;
+}
+
+char *format_int64(char *cursor, int64_t value)
+{
+    if (value < 0)
+    {
+        *cursor++ = '-';
+        return format_uint64(cursor, (uint64_t)0 - (uint64_t)value);
+    }
+    return format_uint64(cursor, (uint64_t)value);
+}
@@ -0,0 +1,46 @@
+#ifndef UTIL_BUFFERED_WRITER_H
+#define UTIL_BUFFERED_WRITER_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#define BUFFERED_WRITER_DEFAULT_CAPACITY (256 * 1024)
+
+typedef struct
+{
+    int fd;
+    char *data;
+    size_t length;
+    size_t capacity;
+    _Bool owns_fd;
+    _Bool has_error;
+
+    // Async mode: a full buffer is swapped with [flush_data] and written by the flusher thread
+    _Bool is_async;
+    _Bool is_closing;
+    _Bool has_flush_error;
+    char *flush_data;
+    size_t flush_length;
+    pthread_t flusher;
+    pthread_mutex_t flush_lock;
+    pthread_cond_t flush_cond;
+} BufferedWriter;
+
+// Path "-" writes to stdout. The file is truncated and then only appended to.
+BufferedWriter *buffered_writer_open(const char *path, size_t capacity);
+// Same as buffered_writer_open, but file writes happen on a background thread,
+// so a slow disk or pipe only blocks the caller when both buffers are full.
+BufferedWriter *buffered_writer_open_async(const char *path, size_t capacity);
+int buffered_writer_write(BufferedWriter *writer, const void *bytes, size_t size);
+int buffered_writer_flush(BufferedWriter *writer);
+int buffered_writer_close(BufferedWriter **writer);
+
+// Integer formatting without printf; both return the position after the last digit (no '\0').
+// [cursor] needs room for 20 characters.
+char *format_uint64(char *cursor, uint64_t value);
+char *format_int64(char *cursor, int64_t value);
+
+#endif
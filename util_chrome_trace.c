@@ -0,0 +1,235 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <pthread.h>
+
+#include "util_chrome_trace.h"
+#include "util_buffered_writer.h"
+
+#define PUMPS_PROCESS_ID 1
+#define TANKERS_PROCESS_ID 2
+#define STATION_PROCESS_ID 3
+
+#define MAX_TRACE_ENTRY_LENGTH 512
+
+static BufferedWriter *chrome_trace_writer = NULL;
+static pthread_mutex_t chrome_trace_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static _Bool is_first_entry = true;
+static int fuel_pumps_count = 0;
+static _Bool *is_pump_waiting_for_fuel = NULL;
+static int named_tankers_count = 0;
+static int cars_waiting_for_pump = 0;
+static int cars_waiting_for_fuel = 0;
+static int64_t last_storage = -1;
+
+static void write_entry(const char *format, ...)
+{
+    char entry[MAX_TRACE_ENTRY_LENGTH];
+    int length = 0;
+    if (!is_first_entry)
+    {
+        entry[length++] = ',';
+        entry[length++] = '\n';
+    }
+    is_first_entry = false;
+
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(entry + length, sizeof(entry) - length, format, args);
+    va_end(args);
+    if (written < 0)
+    {
+        return;
+    }
+    length += written;
+    if ((size_t)length >= sizeof(entry))
+    {
+        length = sizeof(entry) - 1;
+    }
+    buffered_writer_write(chrome_trace_writer, entry, length);
+}
+
+static void write_process_name(int process_id, const char *name)
+{
+    write_entry("{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":%d,\"tid\":0,\"args\":{\"name\":\"%s\"}}", process_id, name);
+}
+
+static void write_thread_name(int process_id, int thread_id, const char *name, int number)
+{
+    write_entry("{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s #%d\"}}", process_id, thread_id, name, number);
+}
+
+// Trace timestamps are microseconds; keep nanosecond precision as a fraction
+static void format_timestamp(uint64_t timestamp_ns, char *result)
+{
+    snprintf(result, 32, "%" PRIu64 ".%03" PRIu64, timestamp_ns / 1000, timestamp_ns % 1000);
+}
+
+static void write_queue_counter(const char *ts)
+{
+    write_entry("{\"ph\":\"C\",\"name\":\"queue length\",\"pid\":%d,\"tid\":0,\"ts\":%s,\"args\":{\"waiting_for_pump\":%d,\"waiting_for_fuel\":%d}}",
+                STATION_PROCESS_ID, ts, cars_waiting_for_pump, cars_waiting_for_fuel);
+}
+
+static void end_fuel_wait(const SimulationEvent *event, const char *ts)
+{
+    if (event->pump_id < 0 || event->pump_id >= fuel_pumps_count || !is_pump_waiting_for_fuel[event->pump_id])
+    {
+        return;
+    }
+    is_pump_waiting_for_fuel[event->pump_id] = false;
+    cars_waiting_for_fuel--;
+    write_entry("{\"ph\":\"E\",\"pid\":%d,\"tid\":%d,\"ts\":%s}", PUMPS_PROCESS_ID, event->pump_id + 1, ts);
+    write_queue_counter(ts);
+}
+
+static void write_car_instant(const SimulationEvent *event, const char *ts, const char *name)
+{
+    write_entry("{\"ph\":\"i\",\"s\":\"t\",\"name\":\"%s\",\"pid\":%d,\"tid\":%d,\"ts\":%s,\"args\":{\"vehicle_id\":%d,\"fuel\":%" PRId64 "}}",
+                name, PUMPS_PROCESS_ID, event->pump_id + 1, ts, event->vehicle_id, event->fuel);
+}
+
+int chrome_trace_open(const char *path, int number_of_fuel_pumps)
+{
+    is_pump_waiting_for_fuel = (_Bool *)calloc(number_of_fuel_pumps, sizeof(_Bool));
+    if (is_pump_waiting_for_fuel == NULL)
+    {
+        printf("❌ Unable to allocate memory for chrome trace pump state.\n");
+        return 0;
+    }
+
+    chrome_trace_writer = buffered_writer_open_async(path, 0);
+    if (chrome_trace_writer == NULL)
+    {
+        printf("❌ Unable to open chrome trace file '%s'.\n", path);
+        free(is_pump_waiting_for_fuel);
+        is_pump_waiting_for_fuel = NULL;
+        return 0;
+    }
+    fuel_pumps_count = number_of_fuel_pumps;
+
+    const char *header = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    buffered_writer_write(chrome_trace_writer, header, strlen(header));
+
+    write_process_name(PUMPS_PROCESS_ID, "⛽️ Fuel pumps");
+    write_process_name(TANKERS_PROCESS_ID, "🚚 Tankers");
+    write_process_name(STATION_PROCESS_ID, "📊 Station");
+    for (int i = 0; i < fuel_pumps_count; i++)
+    {
+        write_thread_name(PUMPS_PROCESS_ID, i + 1, "Fuel pump", i + 1);
+    }
+    return 1;
+}
+
+void chrome_trace_write_event(const SimulationEvent *event)
+{
+    char ts[32];
+    format_timestamp(event->timestamp_ns, ts);
+
+    pthread_mutex_lock(&chrome_trace_lock);
+    if (chrome_trace_writer == NULL)
+    {
+        pthread_mutex_unlock(&chrome_trace_lock);
+        return;
+    }
+
+    _Bool is_pump_event = event->pump_id >= 0 && event->pump_id < fuel_pumps_count;
+    switch (event->kind)
+    {
+    case EVENT_ARRIVAL:
+        cars_waiting_for_pump++;
+        write_queue_counter(ts);
+        break;
+    case EVENT_PUMP_OCCUPY:
+        cars_waiting_for_pump--;
+        if (is_pump_event)
+        {
+            write_entry("{\"ph\":\"B\",\"name\":\"%s #%d\",\"pid\":%d,\"tid\":%d,\"ts\":%s,\"args\":{\"vehicle_type\":\"%s\",\"fuel_required\":%" PRId64 "}}",
+                        get_vehicle_icon(event->vehicle_type), event->vehicle_id, PUMPS_PROCESS_ID, event->pump_id + 1, ts,
+                        get_vehicle_type_name(event->vehicle_type), event->fuel);
+        }
+        write_queue_counter(ts);
+        break;
+    case EVENT_FUEL_WAIT:
+        // A car reports every unsuccessful wake-up; only the first one opens the span
+        if (is_pump_event && !is_pump_waiting_for_fuel[event->pump_id])
+        {
+            is_pump_waiting_for_fuel[event->pump_id] = true;
+            cars_waiting_for_fuel++;
+            write_entry("{\"ph\":\"B\",\"name\":\"waiting for fuel\",\"pid\":%d,\"tid\":%d,\"ts\":%s}", PUMPS_PROCESS_ID, event->pump_id + 1, ts);
+            write_queue_counter(ts);
+        }
+        break;
+    case EVENT_REFUEL:
+        end_fuel_wait(event, ts);
+        if (is_pump_event)
+        {
+            write_car_instant(event, ts, "refuel");
+        }
+        break;
+    case EVENT_TIMEOUT:
+        end_fuel_wait(event, ts);
+        if (is_pump_event)
+        {
+            write_car_instant(event, ts, "timeout");
+        }
+        break;
+    case EVENT_NO_FUEL:
+        end_fuel_wait(event, ts);
+        if (is_pump_event)
+        {
+            write_car_instant(event, ts, "not enough fuel");
+        }
+        break;
+    case EVENT_PUMP_FREE:
+        if (is_pump_event)
+        {
+            write_entry("{\"ph\":\"E\",\"pid\":%d,\"tid\":%d,\"ts\":%s}", PUMPS_PROCESS_ID, event->pump_id + 1, ts);
+        }
+        break;
+    case EVENT_TANKER_UNLOAD:
+        // Tankers are numbered from 1, name each track on its first delivery
+        while (named_tankers_count < event->vehicle_id)
+        {
+            named_tankers_count++;
+            write_thread_name(TANKERS_PROCESS_ID, named_tankers_count, "Tanker", named_tankers_count);
+        }
+        write_entry("{\"ph\":\"i\",\"s\":\"t\",\"name\":\"unload %" PRId64 " L\",\"pid\":%d,\"tid\":%d,\"ts\":%s,\"args\":{\"fuel\":%" PRId64 "}}",
+                    event->fuel, TANKERS_PROCESS_ID, event->vehicle_id, ts, event->fuel);
+        break;
+    default:
+        break;
+    }
+
+    if (event->storage_after >= 0 && event->storage_after != last_storage)
+    {
+        last_storage = event->storage_after;
+        write_entry("{\"ph\":\"C\",\"name\":\"gas_station_fuel_storage\",\"pid\":%d,\"tid\":0,\"ts\":%s,\"args\":{\"liters\":%" PRId64 "}}",
+                    STATION_PROCESS_ID, ts, event->storage_after);
+    }
+    pthread_mutex_unlock(&chrome_trace_lock);
+}
+
+void chrome_trace_close()
+{
+    pthread_mutex_lock(&chrome_trace_lock);
+    if (chrome_trace_writer != NULL)
+    {
+        const char *footer = "\n]}\n";
+        buffered_writer_write(chrome_trace_writer, footer, strlen(footer));
+        if (buffered_writer_close(&chrome_trace_writer) == 0)
+        {
+            printf("❌ Failed to write chrome trace file.\n");
+        }
+    }
+    if (is_pump_waiting_for_fuel != NULL)
+    {
+        free(is_pump_waiting_for_fuel);
+        is_pump_waiting_for_fuel = NULL;
+    }
+    pthread_mutex_unlock(&chrome_trace_lock);
+}
@@ -0,0 +1,12 @@
+#ifndef UTIL_CHROME_TRACE_H
+#define UTIL_CHROME_TRACE_H
+
+#include "util_events.h"
+
+// Chrome trace-event JSON (`--chrome-trace out.json`), opens in Perfetto or chrome://tracing.
+// Events are streamed to the file as they happen; only per-pump state is kept in memory.
+int chrome_trace_open(const char *path, int number_of_fuel_pumps);
+void chrome_trace_write_event(const SimulationEvent *event);
+void chrome_trace_close();
+
+#endif
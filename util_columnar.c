@@ -0,0 +1,220 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "util_columnar.h"
+
+static const char *column_names[COLUMNS_COUNT] = {
+    "vehicle_id",
+    "vehicle_type",
+    "fuel_required",
+    "fuel_received",
+    "wait_ns",
+    "pump_id",
+    "outcome",
+};
+
+static const uint32_t column_element_sizes[COLUMNS_COUNT] = {
+    sizeof(uint32_t),
+    sizeof(uint8_t),
+    sizeof(int32_t),
+    sizeof(int32_t),
+    sizeof(uint64_t),
+    sizeof(int16_t),
+    sizeof(uint8_t),
+};
+
+static uint64_t align_offset(uint64_t offset)
+{
+    return (offset + COLUMNAR_ALIGNMENT - 1) & ~(uint64_t)(COLUMNAR_ALIGNMENT - 1);
+}
+
+const char *get_vehicle_outcome_name(VehicleOutcome outcome)
+{
+    switch (outcome)
+    {
+    case VEHICLE_OUTCOME_REFUELED:
+        return "refueled";
+    case VEHICLE_OUTCOME_TIMEOUT:
+        return "timeout";
+    case VEHICLE_OUTCOME_NO_FUEL:
+        return "no_fuel";
+    default:
+        return "unknown";
+    }
+}
+
+ColumnarWriter *columnar_writer_open(const char *path, uint64_t rows_count, int64_t start_time_unix)
+{
+    ColumnarHeader header;
+    memset(&header, 0, sizeof(ColumnarHeader));
+    memcpy(header.magic, COLUMNAR_MAGIC, sizeof(COLUMNAR_MAGIC));
+    header.version = COLUMNAR_VERSION;
+    header.columns_count = COLUMNS_COUNT;
+    header.rows_count = rows_count;
+    header.start_time_unix = start_time_unix;
+
+    uint64_t offset = align_offset(sizeof(ColumnarHeader));
+    for (int i = 0; i < COLUMNS_COUNT; i++)
+    {
+        strncpy(header.columns[i].name, column_names[i], sizeof(header.columns[i].name) - 1);
+        header.columns[i].element_size = column_element_sizes[i];
+        header.columns[i].offset = offset;
+        offset = align_offset(offset + rows_count * column_element_sizes[i]);
+    }
+
+    ColumnarWriter *writer = (ColumnarWriter *)malloc(sizeof(ColumnarWriter));
+    if (writer == NULL)
+    {
+        printf("❌ Unable to allocate memory for columnar writer.\n");
+        return NULL;
+    }
+    writer->size = (size_t)offset;
+    writer->rows_count = rows_count;
+
+    writer->fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (writer->fd < 0)
+    {
+        printf("❌ Unable to open '%s' for writing: %s\n", path, strerror(errno));
+        free(writer);
+        return NULL;
+    }
+    if (ftruncate(writer->fd, (off_t)writer->size) != 0)
+    {
+        printf("❌ Unable to resize '%s': %s\n", path, strerror(errno));
+        close(writer->fd);
+        free(writer);
+        return NULL;
+    }
+    writer->data = (char *)mmap(NULL, writer->size, PROT_READ | PROT_WRITE, MAP_SHARED, writer->fd, 0);
+    if (writer->data == MAP_FAILED)
+    {
+        printf("❌ Unable to map '%s': %s\n", path, strerror(errno));
+        close(writer->fd);
+        free(writer);
+        return NULL;
+    }
+
+    memcpy(writer->data, &header, sizeof(ColumnarHeader));
+    return writer;
+}
+
+void columnar_writer_set_row(ColumnarWriter *writer, uint64_t row, const VehicleResult *result)
+{
+    if (row >= writer->rows_count)
+    {
+        return;
+    }
+    const ColumnarHeader *header = (const ColumnarHeader *)writer->data;
+    ((uint32_t *)(writer->data + header->columns[COLUMN_VEHICLE_ID].offset))[row] = result->vehicle_id;
+    ((uint8_t *)(writer->data + header->columns[COLUMN_VEHICLE_TYPE].offset))[row] = (uint8_t)result->vehicle_type;
+    ((int32_t *)(writer->data + header->columns[COLUMN_FUEL_REQUIRED].offset))[row] = result->fuel_required;
+    ((int32_t *)(writer->data + header->columns[COLUMN_FUEL_RECEIVED].offset))[row] = result->fuel_received;
+    ((uint64_t *)(writer->data + header->columns[COLUMN_WAIT_NS].offset))[row] = result->wait_ns;
+    ((int16_t *)(writer->data + header->columns[COLUMN_PUMP_ID].offset))[row] = result->pump_id;
+    ((uint8_t *)(writer->data + header->columns[COLUMN_OUTCOME].offset))[row] = (uint8_t)result->outcome;
+}
+
+int columnar_writer_close(ColumnarWriter **writer)
+{
+    if ((*writer) == NULL)
+    {
+        return 1;
+    }
+    int result = 1;
+    if (munmap((*writer)->data, (*writer)->size) != 0)
+    {
+        result = 0;
+    }
+    if (close((*writer)->fd) != 0)
+    {
+        result = 0;
+    }
+    free((*writer));
+    (*writer) = NULL;
+    return result;
+}
+
+ColumnarFile *columnar_file_open(const char *path)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        printf("❌ Unable to open '%s': %s\n", path, strerror(errno));
+        return NULL;
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || (size_t)file_stat.st_size < sizeof(ColumnarHeader))
+    {
+        printf("❌ '%s' is not a columnar results file.\n", path);
+        close(fd);
+        return NULL;
+    }
+
+    size_t size = (size_t)file_stat.st_size;
+    const char *data = (const char *)mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping stays valid after the descriptor is closed
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        printf("❌ Unable to map '%s': %s\n", path, strerror(errno));
+        return NULL;
+    }
+    madvise((void *)data, size, MADV_SEQUENTIAL);
+
+    const ColumnarHeader *header = (const ColumnarHeader *)data;
+    int is_valid = memcmp(header->magic, COLUMNAR_MAGIC, sizeof(COLUMNAR_MAGIC)) == 0 &&
+                   header->version == COLUMNAR_VERSION &&
+                   header->columns_count == COLUMNS_COUNT;
+    for (int i = 0; is_valid && i < COLUMNS_COUNT; i++)
+    {
+        const ColumnDescriptor *column = &header->columns[i];
+        is_valid = column->element_size == column_element_sizes[i] &&
+                   column->offset % COLUMNAR_ALIGNMENT == 0 &&
+                   column->offset <= size &&
+                   header->rows_count <= (size - column->offset) / column->element_size;
+    }
+    if (!is_valid)
+    {
+        printf("❌ '%s' is not a supported columnar results file.\n", path);
+        munmap((void *)data, size);
+        return NULL;
+    }
+
+    ColumnarFile *file = (ColumnarFile *)malloc(sizeof(ColumnarFile));
+    if (file == NULL)
+    {
+        printf("❌ Unable to allocate memory for columnar file.\n");
+        munmap((void *)data, size);
+        return NULL;
+    }
+    file->data = data;
+    file->size = size;
+    file->header = header;
+    return file;
+}
+
+const void *columnar_file_get_column(const ColumnarFile *file, ColumnId column)
+{
+    if (column < 0 || column >= COLUMNS_COUNT)
+    {
+        return NULL;
+    }
+    return file->data + file->header->columns[column].offset;
+}
+
+void columnar_file_close(ColumnarFile **file)
+{
+    if ((*file) == NULL)
+    {
+        return;
+    }
+    munmap((void *)(*file)->data, (*file)->size);
+    free((*file));
+    (*file) = NULL;
+}
@@ -0,0 +1,96 @@
+#ifndef UTIL_COLUMNAR_H
+#define UTIL_COLUMNAR_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "util_vehicle_type.h"
+
+// Columnar per-vehicle results (`--results out.gscol`):
+// one ColumnarHeader followed by one contiguous array per column, each starting on a COLUMNAR_ALIGNMENT boundary.
+// Values are in host (little-endian) byte order, so a mapped column can be used as a plain C array.
+#define COLUMNAR_MAGIC "GSCOLS"
+#define COLUMNAR_VERSION 1
+#define COLUMNAR_ALIGNMENT 64
+
+// Element types: uint32_t, uint8_t (VehicleType), int32_t, int32_t, uint64_t, int16_t (-1 = none), uint8_t (VehicleOutcome)
+typedef enum
+{
+    COLUMN_VEHICLE_ID,
+    COLUMN_VEHICLE_TYPE,
+    COLUMN_FUEL_REQUIRED,
+    COLUMN_FUEL_RECEIVED,
+    COLUMN_WAIT_NS,
+    COLUMN_PUMP_ID,
+    COLUMN_OUTCOME,
+    COLUMNS_COUNT,
+} ColumnId;
+
+typedef enum
+{
+    VEHICLE_OUTCOME_REFUELED,
+    VEHICLE_OUTCOME_TIMEOUT,
+    VEHICLE_OUTCOME_NO_FUEL,
+    VEHICLE_OUTCOMES_COUNT,
+} VehicleOutcome;
+
+typedef struct
+{
+    char name[16];
+    uint32_t element_size;
+    uint32_t reserved;
+    uint64_t offset;
+} ColumnDescriptor;
+
+typedef struct
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t columns_count;
+    uint64_t rows_count;
+    int64_t start_time_unix;
+    ColumnDescriptor columns[COLUMNS_COUNT];
+} ColumnarHeader;
+
+_Static_assert(sizeof(ColumnDescriptor) == 32, "ColumnDescriptor must stay 32 bytes");
+_Static_assert(sizeof(ColumnarHeader) == 32 + COLUMNS_COUNT * 32, "ColumnarHeader must stay packed");
+
+typedef struct
+{
+    uint32_t vehicle_id;
+    VehicleType vehicle_type;
+    int32_t fuel_required;
+    int32_t fuel_received;
+    uint64_t wait_ns;
+    int16_t pump_id;
+    VehicleOutcome outcome;
+} VehicleResult;
+
+// The file is sized up front and mapped, so rows can be set in any order
+typedef struct
+{
+    int fd;
+    char *data;
+    size_t size;
+    uint64_t rows_count;
+} ColumnarWriter;
+
+typedef struct
+{
+    const char *data;
+    size_t size;
+    const ColumnarHeader *header;
+} ColumnarFile;
+
+ColumnarWriter *columnar_writer_open(const char *path, uint64_t rows_count, int64_t start_time_unix);
+void columnar_writer_set_row(ColumnarWriter *writer, uint64_t row, const VehicleResult *result);
+int columnar_writer_close(ColumnarWriter **writer);
+
+ColumnarFile *columnar_file_open(const char *path);
+// Start of the column array, [header->rows_count] elements long
+const void *columnar_file_get_column(const ColumnarFile *file, ColumnId column);
+void columnar_file_close(ColumnarFile **file);
+
+const char *get_vehicle_outcome_name(VehicleOutcome outcome);
+
+#endif
@@ -0,0 +1,204 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <limits.h>
+#include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "util_compiled_scenario.h"
+
+#define FNV_OFFSET_BASIS 0xCBF29CE484222325ULL
+#define FNV_PRIME 0x100000001B3ULL
+
+static uint64_t fnv1a(uint64_t hash, const void *bytes, size_t size)
+{
+    const unsigned char *cursor = (const unsigned char *)bytes;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= cursor[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+static uint64_t get_checksum(const CompiledScenarioHeader *header, const VehicleGroup *groups)
+{
+    uint64_t hash = fnv1a(FNV_OFFSET_BASIS, header, offsetof(CompiledScenarioHeader, checksum));
+    return fnv1a(hash, groups, (size_t)header->vehicle_groups_length * sizeof(VehicleGroup));
+}
+
+int compiled_scenario_write(const char *path, const UserJsonResult *json_result)
+{
+    CompiledScenarioHeader header;
+    memset(&header, 0, sizeof(CompiledScenarioHeader));
+    memcpy(header.magic, COMPILED_SCENARIO_MAGIC, sizeof(COMPILED_SCENARIO_MAGIC));
+    header.version = COMPILED_SCENARIO_VERSION;
+    header.group_size = sizeof(VehicleGroup);
+    header.fuel_pumps_count = json_result->fuel_pumps_count;
+    header.max_vehicle_capacity = json_result->max_vehicle_capacity;
+    header.initial_fuel_in_tanker = json_result->initial_fuel_in_tanker;
+    header.fuel_transfer_rate = json_result->fuel_transfer_rate;
+    header.all_vehicles_length = json_result->all_vehicles_length;
+    header.result_vehicles_length = json_result->result_vehicles_length;
+    header.randomize_arrival = json_result->randomize_arrival;
+    header.vehicle_groups_length = (uint32_t)json_result->vehicle_groups_length;
+    header.checksum = get_checksum(&header, json_result->vehicle_groups);
+
+    FILE *fp = fopen(path, "wb");
+    if (fp == NULL)
+    {
+        printf("❌ Unable to open '%s' for writing: %s\n", path, strerror(errno));
+        return 0;
+    }
+    int result = fwrite(&header, sizeof(CompiledScenarioHeader), 1, fp) == 1 &&
+                 fwrite(json_result->vehicle_groups, sizeof(VehicleGroup), header.vehicle_groups_length, fp) == header.vehicle_groups_length;
+    if (fclose(fp) != 0)
+    {
+        result = 0;
+    }
+    if (!result)
+    {
+        printf("❌ Failed to write compiled scenario '%s'.\n", path);
+    }
+    return result;
+}
+
+int compiled_scenario_is_file(const char *path)
+{
+    char magic[sizeof(COMPILED_SCENARIO_MAGIC)] = "";
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return 0;
+    }
+    if (read(fd, magic, sizeof(magic)) != (ssize_t)sizeof(magic))
+    {
+        magic[0] = '\0';
+    }
+    close(fd);
+    return memcmp(magic, COMPILED_SCENARIO_MAGIC, sizeof(COMPILED_SCENARIO_MAGIC)) == 0;
+}
+
+// The checksum only catches accidental damage. A file written by hand or by another build is held to the
+// same ranges as a parsed scenario, except the --max-* ceilings, which were checked when it was compiled.
+static int is_scenario_consistent(const CompiledScenarioHeader *header, const VehicleGroup *groups)
+{
+    if (header->fuel_pumps_count <= 0 || header->max_vehicle_capacity <= 0 ||
+        header->initial_fuel_in_tanker <= 0 || header->fuel_transfer_rate <= 0 ||
+        header->vehicle_groups_length > INT_MAX)
+    {
+        return 0;
+    }
+    // Same as handle_result_vehicles: the run takes at most max_vehicle_capacity vehicles
+    int64_t result_vehicles_length = header->all_vehicles_length < header->max_vehicle_capacity
+                                         ? header->all_vehicles_length
+                                         : header->max_vehicle_capacity;
+    if (header->result_vehicles_length <= 0 || header->result_vehicles_length != result_vehicles_length)
+    {
+        return 0;
+    }
+    int64_t vehicles_count = 0;
+    for (uint32_t i = 0; i < header->vehicle_groups_length; i++)
+    {
+        if (groups[i].count <= 0 || groups[i].count > INT64_MAX - vehicles_count ||
+            groups[i].vehicle_type < VEHICLE_AUTO || groups[i].vehicle_type >= VEHICLE_NOT_FOUND ||
+            groups[i].fuel_needed <= 0 || groups[i].wait_time_sec < -1)
+        {
+            return 0;
+        }
+        vehicles_count += groups[i].count;
+    }
+    return vehicles_count == header->all_vehicles_length;
+}
+
+CompiledScenario *compiled_scenario_open(const char *path)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        printf("❌ Unable to open '%s': %s\n", path, strerror(errno));
+        return NULL;
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || (size_t)file_stat.st_size < sizeof(CompiledScenarioHeader))
+    {
+        printf("❌ '%s' is not a compiled scenario file.\n", path);
+        close(fd);
+        return NULL;
+    }
+
+    size_t size = (size_t)file_stat.st_size;
+    const char *data = (const char *)mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping stays valid after the descriptor is closed
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        printf("❌ Unable to map '%s': %s\n", path, strerror(errno));
+        return NULL;
+    }
+
+    const CompiledScenarioHeader *header = (const CompiledScenarioHeader *)data;
+    const VehicleGroup *groups = (const VehicleGroup *)(data + sizeof(CompiledScenarioHeader));
+    if (memcmp(header->magic, COMPILED_SCENARIO_MAGIC, sizeof(COMPILED_SCENARIO_MAGIC)) != 0 ||
+        header->version != COMPILED_SCENARIO_VERSION ||
+        header->group_size != sizeof(VehicleGroup) ||
+        (size - sizeof(CompiledScenarioHeader)) / sizeof(VehicleGroup) != header->vehicle_groups_length ||
+        (size - sizeof(CompiledScenarioHeader)) % sizeof(VehicleGroup) != 0)
+    {
+        printf("❌ '%s' is not a supported compiled scenario file.\n", path);
+        munmap((void *)data, size);
+        return NULL;
+    }
+    if (get_checksum(header, groups) != header->checksum)
+    {
+        printf("❌ Compiled scenario '%s' is damaged, compile it again.\n", path);
+        munmap((void *)data, size);
+        return NULL;
+    }
+    if (!is_scenario_consistent(header, groups))
+    {
+        printf("❌ Compiled scenario '%s' has values a scenario can not have, compile it again.\n", path);
+        munmap((void *)data, size);
+        return NULL;
+    }
+
+    CompiledScenario *scenario = (CompiledScenario *)malloc(sizeof(CompiledScenario));
+    if (scenario == NULL)
+    {
+        printf("❌ Unable to allocate memory for compiled scenario.\n");
+        munmap((void *)data, size);
+        return NULL;
+    }
+    scenario->data = data;
+    scenario->size = size;
+
+    UserJsonResult *json_result = &scenario->json_result;
+    json_result->fuel_pumps_count = header->fuel_pumps_count;
+    json_result->max_vehicle_capacity = header->max_vehicle_capacity;
+    json_result->initial_fuel_in_tanker = header->initial_fuel_in_tanker;
+    json_result->fuel_transfer_rate = header->fuel_transfer_rate;
+    json_result->all_vehicles_length = header->all_vehicles_length;
+    json_result->result_vehicles_length = header->result_vehicles_length;
+    json_result->randomize_arrival = header->randomize_arrival != 0;
+    // Same as a parsed scenario: every run draws its own order
+    json_result->random_seed = (uint64_t)time(NULL);
+    json_result->vehicle_groups_length = (int)header->vehicle_groups_length;
+    json_result->vehicle_groups = (VehicleGroup *)groups;
+    return scenario;
+}
+
+void compiled_scenario_close(CompiledScenario **scenario)
+{
+    if ((*scenario) == NULL)
+    {
+        return;
+    }
+    munmap((void *)(*scenario)->data, (*scenario)->size);
+    free((*scenario));
+    (*scenario) = NULL;
+}
@@ -0,0 +1,51 @@
+#ifndef UTIL_COMPILED_SCENARIO_H
+#define UTIL_COMPILED_SCENARIO_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "util_read_data_parser.h"
+
+// Compiled scenario (`validation data.json --compile data.gscen`):
+// one CompiledScenarioHeader followed by the VehicleGroup array, in host (little-endian) byte order.
+// The file is mapped and the groups are used in place, nothing is parsed at startup.
+#define COMPILED_SCENARIO_MAGIC "GSSCEN"
+#define COMPILED_SCENARIO_VERSION 2
+
+typedef struct
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t group_size;
+    int32_t fuel_pumps_count;
+    uint32_t randomize_arrival;
+    int64_t max_vehicle_capacity;
+    int64_t initial_fuel_in_tanker;
+    int64_t fuel_transfer_rate;
+    int64_t all_vehicles_length;
+    int64_t result_vehicles_length;
+    uint32_t vehicle_groups_length;
+    uint32_t reserved;
+    // FNV-1a of the header up to this field and of the group array
+    uint64_t checksum;
+} CompiledScenarioHeader;
+
+_Static_assert(sizeof(CompiledScenarioHeader) == 80, "CompiledScenarioHeader must stay 80 bytes");
+_Static_assert(sizeof(VehicleGroup) == 24, "VehicleGroup is stored as is and must stay 24 bytes");
+
+typedef struct
+{
+    const char *data;
+    size_t size;
+    // [json_result.vehicle_groups] points into the read-only mapping
+    UserJsonResult json_result;
+} CompiledScenario;
+
+// [json_result] must be a successfully validated scenario
+int compiled_scenario_write(const char *path, const UserJsonResult *json_result);
+// Only checks the magic, so a JSON scenario can be told apart without parsing it
+int compiled_scenario_is_file(const char *path);
+CompiledScenario *compiled_scenario_open(const char *path);
+void compiled_scenario_close(CompiledScenario **scenario);
+
+#endif
@@ -0,0 +1,238 @@
+#include <stdio.h>
+#include <math.h>
+#include <inttypes.h>
+
+#include "util_estimate.h"
+#include "utils.h"
+
+// Erlang B by recurrence, then converted to Erlang C; stable for any number of servers
+double erlang_c(int servers, double offered_load)
+{
+    if (servers <= 0 || offered_load <= 0)
+    {
+        return 0;
+    }
+    double utilization = offered_load / servers;
+    if (utilization >= 1)
+    {
+        return 1;
+    }
+    double erlang_b = 1;
+    for (int k = 1; k <= servers; k++)
+    {
+        erlang_b = offered_load * erlang_b / (k + offered_load * erlang_b);
+    }
+    return erlang_b / (1 - utilization * (1 - erlang_b));
+}
+
+// Shares of the cars that leave at once when the storage is empty (wait 0)
+// and, of the cars that do wait, those giving up within [limit_sec]
+static void get_wait_time_shares(const UserJsonResult *json_result, double first_limit_sec, double limit_sec,
+                                 double *zero_share, double *first_short_share, double *short_share)
+{
+    int64_t remaining = json_result->result_vehicles_length;
+    int64_t zero_count = 0;
+    int64_t waiting_count = 0;
+    int64_t first_short_count = 0;
+    int64_t short_count = 0;
+    for (int i = 0; i < json_result->vehicle_groups_length && remaining > 0; i++)
+    {
+        const VehicleGroup *group = &json_result->vehicle_groups[i];
+        // Random arrival samples every group, file order takes whole groups from the start
+        int64_t taken = json_result->randomize_arrival || group->count < remaining ? group->count : remaining;
+        if (!json_result->randomize_arrival)
+        {
+            remaining -= taken;
+        }
+        if (group->wait_time_sec == 0)
+        {
+            zero_count += taken;
+            continue;
+        }
+        waiting_count += taken;
+        // -1 waits forever
+        if (group->wait_time_sec > 0 && group->wait_time_sec <= first_limit_sec)
+        {
+            first_short_count += taken;
+        }
+        if (group->wait_time_sec > 0 && group->wait_time_sec <= limit_sec)
+        {
+            short_count += taken;
+        }
+    }
+    int64_t total_count = zero_count + waiting_count;
+    *zero_share = total_count > 0 ? (double)zero_count / total_count : 0;
+    *first_short_share = waiting_count > 0 ? (double)first_short_count / waiting_count : 0;
+    *short_share = waiting_count > 0 ? (double)short_count / waiting_count : 0;
+}
+
+int queue_estimate_compute(const UserJsonResult *json_result, int tankers_count, QueueEstimate *estimate)
+{
+    uint64_t start_ns = get_monotonic_ns();
+
+    estimate->fuel_pumps_count = json_result->fuel_pumps_count;
+    estimate->vehicles_count = json_result->result_vehicles_length;
+    estimate->total_fuel_required = 0;
+    if (!json_result->randomize_arrival)
+    {
+        // In file order the run takes whole groups, so there is no need to expand them
+        int64_t remaining = json_result->result_vehicles_length;
+        for (int i = 0; i < json_result->vehicle_groups_length && remaining > 0; i++)
+        {
+            const VehicleGroup *group = &json_result->vehicle_groups[i];
+            int64_t taken = group->count < remaining ? group->count : remaining;
+            estimate->total_fuel_required += (double)taken * group->fuel_needed;
+            remaining -= taken;
+        }
+    }
+    else
+    {
+        VehicleIterator vehicle_iterator;
+        if (vehicle_iterator_init(&vehicle_iterator, json_result) == 0)
+        {
+            return 0;
+        }
+        Vehicle vehicle;
+        while (vehicle_iterator_next(&vehicle_iterator, &vehicle))
+        {
+            estimate->total_fuel_required += vehicle.fuel_needed;
+        }
+        vehicle_iterator_close(&vehicle_iterator);
+    }
+    if (estimate->fuel_pumps_count <= 0 || estimate->vehicles_count <= 0 || json_result->fuel_transfer_rate <= 0 || tankers_count <= 0)
+    {
+        printf("❌ [--estimate]: Scenario needs fuel pumps, vehicles and a positive fuel transfer rate.\n");
+        return 0;
+    }
+
+    // As in the simulation, all tankers unload in parallel from one shared initial_fuel_in_tanker pool
+    double delivery_rate = (double)tankers_count * json_result->fuel_transfer_rate / TANKER_UNLOAD_INTERVAL_SEC;
+    double mean_fuel_required = estimate->total_fuel_required / estimate->vehicles_count;
+    estimate->total_fuel_supply = (double)json_result->initial_fuel_in_tanker;
+    estimate->supply_period_sec = TANKER_ARRIVAL_DELAY_SEC +
+                                  ceil(estimate->total_fuel_supply / (delivery_rate * TANKER_UNLOAD_INTERVAL_SEC)) * TANKER_UNLOAD_INTERVAL_SEC;
+
+    int servers = estimate->fuel_pumps_count;
+    estimate->arrival_rate = estimate->vehicles_count / estimate->supply_period_sec;
+    estimate->service_rate = mean_fuel_required > 0 ? delivery_rate / mean_fuel_required / servers : INFINITY;
+    estimate->mean_service_time_sec = isinf(estimate->service_rate) ? 0 : 1 / estimate->service_rate;
+
+    double offered_load = estimate->arrival_rate * estimate->mean_service_time_sec;
+    estimate->utilization = offered_load / servers;
+    estimate->is_saturated = estimate->utilization >= 1;
+    estimate->wait_probability = erlang_c(servers, offered_load);
+    if (estimate->is_saturated)
+    {
+        // No steady state: the queue grows linearly over the supply period,
+        // so waits are spread evenly between 0 and twice the mean
+        double drain_rate = servers * estimate->service_rate;
+        estimate->throughput = drain_rate;
+        estimate->mean_queue_length = (estimate->arrival_rate - drain_rate) * estimate->supply_period_sec / 2;
+        estimate->mean_queue_wait_sec = estimate->mean_queue_length / estimate->arrival_rate;
+        estimate->queue_wait_p95_sec = 0.95 * 2 * estimate->mean_queue_wait_sec;
+    }
+    else
+    {
+        // P(Wq > t) = C * e^(-(cμ - λ)t)
+        double decay_rate = servers * estimate->service_rate - estimate->arrival_rate;
+        estimate->throughput = estimate->arrival_rate;
+        estimate->mean_queue_wait_sec = isinf(decay_rate) ? 0 : estimate->wait_probability / decay_rate;
+        estimate->queue_wait_p95_sec = estimate->wait_probability > 0.05 && !isinf(decay_rate) ? log(estimate->wait_probability / 0.05) / decay_rate : 0;
+        estimate->mean_queue_length = estimate->arrival_rate * estimate->mean_queue_wait_sec;
+    }
+
+    // Not part of the M/M/c model: a heuristic of the delivery steps, checked against simulated runs.
+    // Refueling itself is instant, so every delivery serves the parked cars and then whoever fits in the storage;
+    // when it runs dry, the next [servers] cars park until enough deliveries cover them. Wait-0 cars leave
+    // instead of parking, cars with a shorter wait_time_sec give up at the first delivery past it.
+    double cars_per_delivery = mean_fuel_required > 0 ? delivery_rate * TANKER_UNLOAD_INTERVAL_SEC / mean_fuel_required : INFINITY;
+    double deliveries_per_wait = fmax(1, ceil(servers / cars_per_delivery));
+    estimate->fuel_wait_sec = deliveries_per_wait * TANKER_UNLOAD_INTERVAL_SEC;
+    estimate->first_fuel_wait_sec = TANKER_ARRIVAL_DELAY_SEC + estimate->fuel_wait_sec - TANKER_UNLOAD_INTERVAL_SEC;
+    double zero_share, first_short_share, short_share;
+    get_wait_time_shares(json_result, estimate->first_fuel_wait_sec, estimate->fuel_wait_sec,
+                         &zero_share, &first_short_share, &short_share);
+
+    double cars_served = mean_fuel_required > 0 ? fmin(estimate->vehicles_count, estimate->total_fuel_supply / mean_fuel_required)
+                                                : estimate->vehicles_count;
+    double cars_timed_out = 0;
+    if (zero_share >= 1)
+    {
+        // The storage starts empty, so nobody stays for the first delivery
+        cars_timed_out = estimate->vehicles_count;
+    }
+    else if (!isinf(cars_per_delivery))
+    {
+        // Per wait: the delivered fuel serves some cars, the parked ones that give up and the wait-0 cars
+        // that pass through the pumps meanwhile leave without it
+        double cars_left_per_wait = servers * zero_share / (1 - zero_share) + servers * short_share;
+        double cars_per_wait = deliveries_per_wait * cars_per_delivery + cars_left_per_wait;
+        double supply_waits = estimate->total_fuel_supply / (delivery_rate * estimate->fuel_wait_sec);
+        double waits = fmin(estimate->vehicles_count / cars_per_wait, fmax(supply_waits, 1));
+        cars_timed_out = servers * (first_short_share - short_share) + waits * cars_left_per_wait;
+        cars_timed_out = fmin(fmax(cars_timed_out, 0), estimate->vehicles_count);
+    }
+    cars_served = fmin(cars_served, estimate->vehicles_count - cars_timed_out);
+    estimate->timeout_probability = cars_timed_out / estimate->vehicles_count;
+    estimate->starvation_probability = 1 - cars_served / estimate->vehicles_count;
+    // Only served cars count, so the throughput carries the heuristic too
+    estimate->throughput *= 1 - estimate->starvation_probability;
+
+    estimate->compute_ns = get_monotonic_ns() - start_ns;
+    return 1;
+}
+
+void queue_estimate_print(const QueueEstimate *estimate)
+{
+    printf("\n");
+    printf("🧮 ESTIMATE (M/M/%d):\n", estimate->fuel_pumps_count);
+    printf("\n");
+    printf("🚗 %" PRId64 " vehicles need %.0f liters, tankers bring %.0f liters over %.0f seconds.\n",
+           estimate->vehicles_count, estimate->total_fuel_required, estimate->total_fuel_supply, estimate->supply_period_sec);
+    printf("   ├─ Arrival rate λ = %.3f vehicles/s, service rate μ = %.3f vehicles/s per pump.\n", estimate->arrival_rate, estimate->service_rate);
+    printf("   ├─ Utilization ρ = %.1f%%%s\n", 100 * estimate->utilization, estimate->is_saturated ? " (saturated, queue keeps growing)" : ".");
+    printf("   ├─ Probability to wait for a pump: %.1f%%.\n", 100 * estimate->wait_probability);
+    printf("   ├─ ⏳ Expected wait for a pump %.3f seconds (p95 %.3f), time at the pump %.3f seconds.\n",
+           estimate->mean_queue_wait_sec, estimate->queue_wait_p95_sec, estimate->mean_service_time_sec);
+    printf("   ├─ Expected queue length (Little's law): %.2f vehicles.\n", estimate->mean_queue_length);
+    printf("   ├─ Throughput: %.3f vehicles/s.\n", estimate->throughput);
+    printf("   └─ Heuristic, outside the M/M/c model:\n");
+    printf("      ├─ ⛽️ First delivery after %.0f seconds, parked cars wait %.0f seconds for it and %.0f for later ones.\n",
+           (double)TANKER_ARRIVAL_DELAY_SEC, estimate->first_fuel_wait_sec, estimate->fuel_wait_sec);
+    printf("      ├─ Leaving before the fuel arrives: %.1f%%.\n", 100 * estimate->timeout_probability);
+    printf("      └─ ❌ Left without fuel (timeouts and supply): %.1f%%.\n", 100 * estimate->starvation_probability);
+    printf("\n");
+    printf("Computed in %.1f µs.\n", estimate->compute_ns / 1e3);
+}
+
+static int print_comparison_line(const char *name, double estimated, double simulated)
+{
+    double scale = fmax(fabs(estimated), fabs(simulated));
+    _Bool is_diverging = scale > 0 && fabs(estimated - simulated) / scale > ESTIMATE_DIVERGENCE_THRESHOLD;
+    printf("   %-28s %10.3f %10.3f%s\n", name, estimated, simulated, is_diverging ? "  ⚠️ diverges" : "");
+    return is_diverging;
+}
+
+int queue_estimate_compare(const QueueEstimate *estimate, const SimulatedRun *simulated)
+{
+    printf("\n");
+    printf("🧮 ESTIMATE vs SIMULATION:\n");
+    printf("\n");
+    printf("   %-28s %10s %10s\n", "", "estimate", "simulated");
+    int diverging_count = 0;
+    diverging_count += print_comparison_line("Duration (s)", estimate->supply_period_sec, simulated->duration_sec);
+    diverging_count += print_comparison_line("Pump utilization (%)", 100 * fmin(estimate->utilization, 1), 100 * simulated->utilization);
+    diverging_count += print_comparison_line("Time at the pump (s)", estimate->mean_service_time_sec, simulated->mean_service_time_sec);
+    diverging_count += print_comparison_line("Throughput (vehicles/s)", estimate->throughput, simulated->throughput);
+    diverging_count += print_comparison_line("Left without fuel (%, heur.)", 100 * estimate->starvation_probability, 100 * simulated->starvation_probability);
+    printf("\n");
+    if (diverging_count > 0)
+    {
+        printf("⚠️  %d metric(s) differ from the M/M/c estimate by more than %.0f%%.\n", diverging_count, 100 * ESTIMATE_DIVERGENCE_THRESHOLD);
+    }
+    else
+    {
+        printf("✅ Simulation agrees with the M/M/c estimate within %.0f%%.\n", 100 * ESTIMATE_DIVERGENCE_THRESHOLD);
+    }
+    return diverging_count;
+}
@@ -0,0 +1,66 @@
+#ifndef UTIL_ESTIMATE_H
+#define UTIL_ESTIMATE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "util_read_data_parser.h"
+
+// Tankers start unloading this long after the cars arrive, then unload once per interval
+#define TANKER_ARRIVAL_DELAY_SEC 2
+#define TANKER_UNLOAD_INTERVAL_SEC 1
+
+// Relative difference between the estimate and a simulated run reported as a divergence
+#define ESTIMATE_DIVERGENCE_THRESHOLD 0.25
+
+// Closed-form M/M/c estimate of a scenario (`--estimate`).
+// Every car arrives at the start and pumps are limited by fuel deliveries rather than by dispensing,
+// so arrivals are spread over the supply period and the delivery rate, shared by all pumps, is the service rate.
+typedef struct
+{
+    int fuel_pumps_count;
+    int64_t vehicles_count;
+    double total_fuel_required;
+    double total_fuel_supply;
+    double supply_period_sec;
+    double arrival_rate;
+    double service_rate;
+    double utilization;
+    bool is_saturated;
+    // Erlang C: probability that an arriving car finds every pump busy
+    double wait_probability;
+    double mean_queue_wait_sec;
+    double queue_wait_p95_sec;
+    // Little's law: Lq = λ * Wq
+    double mean_queue_length;
+    double mean_service_time_sec;
+    double throughput;
+    // Heuristic, not part of the M/M/c model, tuned against simulated runs.
+    // Cars that find the storage empty wait at a pump for the next delivery: the first one comes after
+    // TANKER_ARRIVAL_DELAY_SEC, later ones every interval, enough of them to fill the parked cars
+    double first_fuel_wait_sec;
+    double fuel_wait_sec;
+    // Share of the cars whose wait_time_sec runs out before their fuel arrives
+    double timeout_probability;
+    // Timeouts plus the cars whose fuel is not covered by the tankers
+    double starvation_probability;
+    uint64_t compute_ns;
+} QueueEstimate;
+
+// Measured counterparts of the estimate, taken from a finished simulation
+typedef struct
+{
+    double duration_sec;
+    double utilization;
+    double mean_service_time_sec;
+    double throughput;
+    double starvation_probability;
+} SimulatedRun;
+
+double erlang_c(int servers, double offered_load);
+int queue_estimate_compute(const UserJsonResult *json_result, int tankers_count, QueueEstimate *estimate);
+void queue_estimate_print(const QueueEstimate *estimate);
+// Prints estimate and simulation side by side and returns the number of diverging metrics
+int queue_estimate_compare(const QueueEstimate *estimate, const SimulatedRun *simulated);
+
+#endif
@@ -0,0 +1,79 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#include "util_event_stream.h"
+#include "util_buffered_writer.h"
+
+#define MAX_EVENT_LINE_LENGTH 256
+
+static BufferedWriter *event_stream_writer = NULL;
+static pthread_mutex_t event_stream_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static char *append_string(char *cursor, const char *value)
+{
+    size_t length = strlen(value);
+    memcpy(cursor, value, length);
+    return cursor + length;
+}
+
+// Negative values mean "not applicable" and are written as null
+static char *append_optional_int64(char *cursor, int64_t value)
+{
+    if (value < 0)
+    {
+        return append_string(cursor, "null");
+    }
+    return format_uint64(cursor, (uint64_t)value);
+}
+
+int event_stream_open(const char *path)
+{
+    event_stream_writer = buffered_writer_open_async(path, 0);
+    if (event_stream_writer == NULL)
+    {
+        printf("❌ Unable to open event stream '%s'.\n", path);
+        return 0;
+    }
+    return 1;
+}
+
+void event_stream_write_event(const SimulationEvent *event)
+{
+    char line[MAX_EVENT_LINE_LENGTH];
+    char *cursor = line;
+
+    cursor = append_string(cursor, "{\"ts\":");
+    cursor = format_uint64(cursor, event->timestamp_ns);
+    cursor = append_string(cursor, ",\"kind\":\"");
+    cursor = append_string(cursor, get_event_kind_name(event->kind));
+    cursor = append_string(cursor, "\",\"vehicle_id\":");
+    cursor = format_int64(cursor, event->vehicle_id);
+    cursor = append_string(cursor, ",\"vehicle_type\":\"");
+    cursor = append_string(cursor, event->kind == EVENT_TANKER_UNLOAD ? "tanker" : get_vehicle_type_name(event->vehicle_type));
+    cursor = append_string(cursor, "\",\"pump_id\":");
+    cursor = append_optional_int64(cursor, event->pump_id);
+    cursor = append_string(cursor, ",\"fuel\":");
+    cursor = format_int64(cursor, event->fuel);
+    cursor = append_string(cursor, ",\"storage_after\":");
+    cursor = append_optional_int64(cursor, event->storage_after);
+    cursor = append_string(cursor, "}\n");
+
+    pthread_mutex_lock(&event_stream_lock);
+    if (event_stream_writer != NULL)
+    {
+        buffered_writer_write(event_stream_writer, line, (size_t)(cursor - line));
+    }
+    pthread_mutex_unlock(&event_stream_lock);
+}
+
+void event_stream_close()
+{
+    pthread_mutex_lock(&event_stream_lock);
+    if (event_stream_writer != NULL && buffered_writer_close(&event_stream_writer) == 0)
+    {
+        printf("❌ Failed to write event stream.\n");
+    }
+    pthread_mutex_unlock(&event_stream_lock);
+}
@@ -0,0 +1,12 @@
+#ifndef UTIL_EVENT_STREAM_H
+#define UTIL_EVENT_STREAM_H
+
+#include "util_events.h"
+
+// JSON-lines event stream (`--events jsonl`): one compact object per event,
+// {"ts":<ns>,"kind":"...","vehicle_id":N,"vehicle_type":"...","pump_id":N|null,"fuel":N,"storage_after":N|null}
+int event_stream_open(const char *path);
+void event_stream_write_event(const SimulationEvent *event);
+void event_stream_close();
+
+#endif
@@ -0,0 +1,26 @@
+#include "util_events.h"
+
+const char *get_event_kind_name(EventKind kind)
+{
+    switch (kind)
+    {
+    case EVENT_ARRIVAL:
+        return "arrival";
+    case EVENT_PUMP_OCCUPY:
+        return "pump_occupy";
+    case EVENT_PUMP_FREE:
+        return "pump_free";
+    case EVENT_FUEL_WAIT:
+        return "fuel_wait";
+    case EVENT_REFUEL:
+        return "refuel";
+    case EVENT_TIMEOUT:
+        return "timeout";
+    case EVENT_NO_FUEL:
+        return "no_fuel";
+    case EVENT_TANKER_UNLOAD:
+        return "tanker_unload";
+    default:
+        return "unknown";
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef UTIL_EVENTS_H
+#define UTIL_EVENTS_H
+
+#include <stdint.h>
+
+#include "util_vehicle_type.h"
+
+typedef enum
+{
+    EVENT_ARRIVAL,
+    EVENT_PUMP_OCCUPY,
+    EVENT_PUMP_FREE,
+    EVENT_FUEL_WAIT,
+    EVENT_REFUEL,
+    EVENT_TIMEOUT,
+    EVENT_NO_FUEL,
+    EVENT_TANKER_UNLOAD,
+    EVENT_KINDS_COUNT,
+} EventKind;
+
+// One state change of the simulation.
+// For tanker events [vehicle_id] is the tanker number and [vehicle_type] is VEHICLE_NOT_FOUND.
+// [pump_id] is 0-based, -1 when the event is not bound to a pump.
+// [storage_after] is -1 when the event happened outside of `dynamic_lock`.
+typedef struct
+{
+    uint64_t timestamp_ns;
+    EventKind kind;
+    int vehicle_id;
+    VehicleType vehicle_type;
+    int pump_id;
+    int64_t fuel;
+    int64_t storage_after;
+} SimulationEvent;
+
+const char *get_event_kind_name(EventKind kind);
+
+#endif
@@ -0,0 +1,133 @@
+#include <string.h>
+#include <math.h>
+
+#include "util_histogram.h"
+
+void histogram_init(Histogram *histogram)
+{
+    memset(histogram, 0, sizeof(Histogram));
+    histogram->min = UINT64_MAX;
+}
+
+int histogram_get_bucket_index(uint64_t value)
+{
+    if (value < 2 * HISTOGRAM_SUB_BUCKET_COUNT)
+    {
+        return (int)value;
+    }
+    if (value >> HISTOGRAM_MAX_VALUE_BITS)
+    {
+        return HISTOGRAM_BUCKETS_COUNT - 1;
+    }
+    // [exponent] is the position of the highest set bit, [mantissa] the next HISTOGRAM_SUB_BUCKET_BITS bits
+    int exponent = 63 - __builtin_clzll(value);
+    int shift = exponent - HISTOGRAM_SUB_BUCKET_BITS;
+    int mantissa = (int)(value >> shift) - HISTOGRAM_SUB_BUCKET_COUNT;
+    return (shift + 1) * HISTOGRAM_SUB_BUCKET_COUNT + mantissa;
+}
+
+// Highest value that falls into the bucket
+uint64_t histogram_get_bucket_upper_value(int index)
+{
+    if (index < 2 * HISTOGRAM_SUB_BUCKET_COUNT)
+    {
+        return (uint64_t)index;
+    }
+    int shift = index / HISTOGRAM_SUB_BUCKET_COUNT - 1;
+    uint64_t mantissa = (uint64_t)(index % HISTOGRAM_SUB_BUCKET_COUNT + HISTOGRAM_SUB_BUCKET_COUNT);
+    return ((mantissa + 1) << shift) - 1;
+}
+
+void histogram_record(Histogram *histogram, uint64_t value)
+{
+    histogram->count++;
+    double delta = (double)value - histogram->mean;
+    histogram->mean += delta / (double)histogram->count;
+    histogram->m2 += delta * ((double)value - histogram->mean);
+
+    if (value < histogram->min)
+    {
+        histogram->min = value;
+    }
+    if (value > histogram->max)
+    {
+        histogram->max = value;
+    }
+    histogram->buckets[histogram_get_bucket_index(value)]++;
+}
+
+void histogram_merge(Histogram *destination, const Histogram *source)
+{
+    if (source->count == 0)
+    {
+        return;
+    }
+    // Chan et al. parallel variant of Welford's algorithm
+    uint64_t count = destination->count + source->count;
+    double delta = source->mean - destination->mean;
+    destination->m2 += source->m2 + delta * delta * ((double)destination->count * (double)source->count / (double)count);
+    destination->mean += delta * ((double)source->count / (double)count);
+    destination->count = count;
+
+    if (source->min < destination->min)
+    {
+        destination->min = source->min;
+    }
+    if (source->max > destination->max)
+    {
+        destination->max = source->max;
+    }
+    for (int i = 0; i < HISTOGRAM_BUCKETS_COUNT; i++)
+    {
+        destination->buckets[i] += source->buckets[i];
+    }
+}
+
+double histogram_get_variance(const Histogram *histogram)
+{
+    if (histogram->count < 2)
+    {
+        return 0;
+    }
+    return histogram->m2 / (double)(histogram->count - 1);
+}
+
+double histogram_get_stddev(const Histogram *histogram)
+{
+    return sqrt(histogram_get_variance(histogram));
+}
+
+uint64_t histogram_get_percentile(const Histogram *histogram, double percentile)
+{
+    if (histogram->count == 0)
+    {
+        return 0;
+    }
+    uint64_t rank = (uint64_t)ceil(percentile / 100.0 * (double)histogram->count);
+    if (rank == 0)
+    {
+        rank = 1;
+    }
+
+    uint64_t seen = 0;
+    for (int i = 0; i < HISTOGRAM_BUCKETS_COUNT; i++)
+    {
+        seen += histogram->buckets[i];
+        if (seen >= rank)
+        {
+            uint64_t value = histogram_get_bucket_upper_value(i);
+            return value > histogram->max ? histogram->max : value;
+        }
+    }
+    return histogram->max;
+}
+
+uint64_t histogram_count_at_or_below(const Histogram *histogram, uint64_t value)
+{
+    uint64_t count = 0;
+    for (int i = 0; i < HISTOGRAM_BUCKETS_COUNT && histogram_get_bucket_upper_value(i) <= value; i++)
+    {
+        count += histogram->buckets[i];
+    }
+    return count;
+}
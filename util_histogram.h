@@ -0,0 +1,37 @@
+#ifndef UTIL_HISTOGRAM_H
+#define UTIL_HISTOGRAM_H
+
+#include <stdint.h>
+
+// HDR-style log-bucketed histogram with Welford mean/variance, for wait times in microseconds.
+// Values below 2^HISTOGRAM_SUB_BUCKET_BITS are exact; every power of two above is split into
+// 2^HISTOGRAM_SUB_BUCKET_BITS sub-buckets, so a reported percentile is within ~3% of the real value.
+// Values from 2^HISTOGRAM_MAX_VALUE_BITS us (~12 days) land in the last bucket.
+#define HISTOGRAM_SUB_BUCKET_BITS 5
+#define HISTOGRAM_SUB_BUCKET_COUNT (1 << HISTOGRAM_SUB_BUCKET_BITS)
+#define HISTOGRAM_MAX_VALUE_BITS 40
+#define HISTOGRAM_BUCKETS_COUNT ((HISTOGRAM_MAX_VALUE_BITS - HISTOGRAM_SUB_BUCKET_BITS + 1) * HISTOGRAM_SUB_BUCKET_COUNT)
+
+typedef struct
+{
+    uint64_t count;
+    double mean;
+    double m2;
+    uint64_t min;
+    uint64_t max;
+    uint64_t buckets[HISTOGRAM_BUCKETS_COUNT];
+} Histogram;
+
+void histogram_init(Histogram *histogram);
+void histogram_record(Histogram *histogram, uint64_t value);
+// Histograms from other threads or replications can be merged in any order
+void histogram_merge(Histogram *destination, const Histogram *source);
+double histogram_get_variance(const Histogram *histogram);
+double histogram_get_stddev(const Histogram *histogram);
+uint64_t histogram_get_percentile(const Histogram *histogram, double percentile);
+// Number of recorded values whose bucket lies entirely at or below [value]
+uint64_t histogram_count_at_or_below(const Histogram *histogram, uint64_t value);
+int histogram_get_bucket_index(uint64_t value);
+uint64_t histogram_get_bucket_upper_value(int index);
+
+#endif
@@ -0,0 +1,651 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "util_json_tokenizer.h"
+
+typedef enum
+{
+    EXPECT_VALUE,
+    EXPECT_VALUE_OR_END,
+    EXPECT_KEY,
+    EXPECT_KEY_OR_END,
+    EXPECT_COMMA_OR_END,
+    EXPECT_NOTHING,
+} TokenizerState;
+
+static JsonTokenizer *create_tokenizer()
+{
+    JsonTokenizer *tokenizer = (JsonTokenizer *)calloc(1, sizeof(JsonTokenizer));
+    if (tokenizer == NULL)
+    {
+        errno = ENOMEM;
+        return NULL;
+    }
+    tokenizer->text_capacity = 256;
+    tokenizer->text = (char *)malloc(tokenizer->text_capacity);
+    if (tokenizer->text == NULL)
+    {
+        free(tokenizer);
+        errno = ENOMEM;
+        return NULL;
+    }
+    tokenizer->text[0] = '\0';
+    tokenizer->fd = -1;
+    tokenizer->state = EXPECT_VALUE;
+    tokenizer->line = 1;
+    return tokenizer;
+}
+
+// Regular files are mapped and tokenized in place; returns 0 to fall back to reading
+static int map_file(JsonTokenizer *tokenizer)
+{
+    struct stat file_stat;
+    if (fstat(tokenizer->fd, &file_stat) != 0 || !S_ISREG(file_stat.st_mode) || file_stat.st_size <= 0)
+    {
+        return 0;
+    }
+    size_t size = (size_t)file_stat.st_size;
+    void *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, tokenizer->fd, 0);
+    if (data == MAP_FAILED)
+    {
+        return 0;
+    }
+    madvise(data, size, MADV_SEQUENTIAL);
+
+    tokenizer->data = (const char *)data;
+    tokenizer->length = size;
+    tokenizer->mapped_size = size;
+    tokenizer->is_eof = true;
+    return 1;
+}
+
+JsonTokenizer *json_tokenizer_open(const char *path)
+{
+    JsonTokenizer *tokenizer = create_tokenizer();
+    if (tokenizer == NULL)
+    {
+        return NULL;
+    }
+
+    if (strcmp(path, "-") == 0)
+    {
+        tokenizer->fd = STDIN_FILENO;
+        tokenizer->owns_fd = false;
+    }
+    else
+    {
+        tokenizer->fd = open(path, O_RDONLY);
+        tokenizer->owns_fd = true;
+    }
+    if (tokenizer->fd < 0)
+    {
+        int open_errno = errno;
+        tokenizer->owns_fd = false;
+        json_tokenizer_close(&tokenizer);
+        errno = open_errno;
+        return NULL;
+    }
+    // stdin may already be read from, so only files opened here are mapped
+    if (tokenizer->owns_fd && map_file(tokenizer))
+    {
+        close(tokenizer->fd);
+        tokenizer->fd = -1;
+        tokenizer->owns_fd = false;
+        return tokenizer;
+    }
+
+    // Pipes, sockets and empty files are read in chunks
+    tokenizer->read_buffer = (char *)malloc(JSON_TOKENIZER_CHUNK_SIZE);
+    if (tokenizer->read_buffer == NULL)
+    {
+        json_tokenizer_close(&tokenizer);
+        errno = ENOMEM;
+        return NULL;
+    }
+    tokenizer->data = tokenizer->read_buffer;
+    return tokenizer;
+}
+
+JsonTokenizer *json_tokenizer_open_buffer(const char *data, size_t size)
+{
+    JsonTokenizer *tokenizer = create_tokenizer();
+    if (tokenizer == NULL)
+    {
+        return NULL;
+    }
+    tokenizer->data = data;
+    tokenizer->length = size;
+    tokenizer->is_eof = true;
+    return tokenizer;
+}
+
+void json_tokenizer_close(JsonTokenizer **tokenizer)
+{
+    if ((*tokenizer) == NULL)
+    {
+        return;
+    }
+    if ((*tokenizer)->owns_fd)
+    {
+        close((*tokenizer)->fd);
+    }
+    if ((*tokenizer)->mapped_size > 0)
+    {
+        munmap((void *)(*tokenizer)->data, (*tokenizer)->mapped_size);
+    }
+    free((*tokenizer)->read_buffer);
+    free((*tokenizer)->text);
+    free((*tokenizer));
+    (*tokenizer) = NULL;
+}
+
+uint32_t json_key_hash(const char *key, size_t length)
+{
+    uint32_t hash = 0x811C9DC5u;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= (unsigned char)key[i];
+        hash *= 0x01000193u;
+    }
+    return hash;
+}
+
+static JsonTokenType set_error(JsonTokenizer *tokenizer, const char *format, ...)
+{
+    int length = snprintf(tokenizer->error, sizeof(tokenizer->error), "line %d: ", tokenizer->line);
+    va_list args;
+    va_start(args, format);
+    vsnprintf(tokenizer->error + length, sizeof(tokenizer->error) - length, format, args);
+    va_end(args);
+    tokenizer->state = EXPECT_NOTHING;
+    return JSON_TOKEN_ERROR;
+}
+
+// Next byte without consuming it, -1 at the end of input
+static int peek_char(JsonTokenizer *tokenizer)
+{
+    if (tokenizer->position < tokenizer->length)
+    {
+        return (unsigned char)tokenizer->data[tokenizer->position];
+    }
+    while (!tokenizer->is_eof)
+    {
+        ssize_t bytes_read = read(tokenizer->fd, tokenizer->read_buffer, JSON_TOKENIZER_CHUNK_SIZE);
+        if (bytes_read < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (bytes_read <= 0)
+        {
+            tokenizer->is_eof = true;
+            break;
+        }
+        tokenizer->length = (size_t)bytes_read;
+        tokenizer->position = 0;
+        return (unsigned char)tokenizer->data[0];
+    }
+    return -1;
+}
+
+static int next_char(JsonTokenizer *tokenizer)
+{
+    int c = peek_char(tokenizer);
+    if (c != -1)
+    {
+        tokenizer->position++;
+    }
+    return c;
+}
+
+static void skip_whitespace(JsonTokenizer *tokenizer)
+{
+    while (true)
+    {
+        int c = peek_char(tokenizer);
+        if (c == '\n')
+        {
+            tokenizer->line++;
+        }
+        else if (c != ' ' && c != '\t' && c != '\r')
+        {
+            return;
+        }
+        tokenizer->position++;
+    }
+}
+
+static int append_text(JsonTokenizer *tokenizer, char c)
+{
+    if (tokenizer->text_length + 1 >= tokenizer->text_capacity)
+    {
+        size_t capacity = tokenizer->text_capacity * 2;
+        char *text = (char *)realloc(tokenizer->text, capacity);
+        if (text == NULL)
+        {
+            return 0;
+        }
+        tokenizer->text = text;
+        tokenizer->text_capacity = capacity;
+    }
+    tokenizer->text[tokenizer->text_length++] = c;
+    tokenizer->text[tokenizer->text_length] = '\0';
+    return 1;
+}
+
+static int append_bytes(JsonTokenizer *tokenizer, const char *bytes, size_t size)
+{
+    if (tokenizer->text_length + size >= tokenizer->text_capacity)
+    {
+        size_t capacity = tokenizer->text_capacity * 2;
+        while (tokenizer->text_length + size >= capacity)
+        {
+            capacity *= 2;
+        }
+        char *text = (char *)realloc(tokenizer->text, capacity);
+        if (text == NULL)
+        {
+            return 0;
+        }
+        tokenizer->text = text;
+        tokenizer->text_capacity = capacity;
+    }
+    memcpy(tokenizer->text + tokenizer->text_length, bytes, size);
+    tokenizer->text_length += size;
+    tokenizer->text[tokenizer->text_length] = '\0';
+    return 1;
+}
+
+static int append_utf8(JsonTokenizer *tokenizer, uint32_t code_point)
+{
+    if (code_point < 0x80)
+    {
+        return append_text(tokenizer, (char)code_point);
+    }
+    if (code_point < 0x800)
+    {
+        return append_text(tokenizer, (char)(0xC0 | (code_point >> 6))) &&
+               append_text(tokenizer, (char)(0x80 | (code_point & 0x3F)));
+    }
+    if (code_point < 0x10000)
+    {
+        return append_text(tokenizer, (char)(0xE0 | (code_point >> 12))) &&
+               append_text(tokenizer, (char)(0x80 | ((code_point >> 6) & 0x3F))) &&
+               append_text(tokenizer, (char)(0x80 | (code_point & 0x3F)));
+    }
+    return append_text(tokenizer, (char)(0xF0 | (code_point >> 18))) &&
+           append_text(tokenizer, (char)(0x80 | ((code_point >> 12) & 0x3F))) &&
+           append_text(tokenizer, (char)(0x80 | ((code_point >> 6) & 0x3F))) &&
+           append_text(tokenizer, (char)(0x80 | (code_point & 0x3F)));
+}
+
+static int read_hex4(JsonTokenizer *tokenizer, uint32_t *value)
+{
+    *value = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        int c = next_char(tokenizer);
+        *value <<= 4;
+        if (c >= '0' && c <= '9')
+        {
+            *value |= (uint32_t)(c - '0');
+        }
+        else if (c >= 'a' && c <= 'f')
+        {
+            *value |= (uint32_t)(c - 'a' + 10);
+        }
+        else if (c >= 'A' && c <= 'F')
+        {
+            *value |= (uint32_t)(c - 'A' + 10);
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// The opening quote is already consumed
+static JsonTokenType read_string(JsonTokenizer *tokenizer, JsonTokenType type)
+{
+    tokenizer->text_length = 0;
+    tokenizer->text[0] = '\0';
+    while (true)
+    {
+        // Copy the run of plain characters already in memory at once
+        size_t run_end = tokenizer->position;
+        while (run_end < tokenizer->length)
+        {
+            unsigned char b = (unsigned char)tokenizer->data[run_end];
+            if (b == '"' || b == '\\' || b < 0x20)
+            {
+                break;
+            }
+            run_end++;
+        }
+        if (run_end > tokenizer->position)
+        {
+            if (!append_bytes(tokenizer, tokenizer->data + tokenizer->position, run_end - tokenizer->position))
+            {
+                return set_error(tokenizer, "out of memory");
+            }
+            tokenizer->position = run_end;
+        }
+
+        int c = next_char(tokenizer);
+        if (c == -1)
+        {
+            return set_error(tokenizer, "unterminated string");
+        }
+        if (c == '"')
+        {
+            return type;
+        }
+        if (c < 0x20)
+        {
+            return set_error(tokenizer, "control character in string");
+        }
+        if (c != '\\')
+        {
+            if (!append_text(tokenizer, (char)c))
+            {
+                return set_error(tokenizer, "out of memory");
+            }
+            continue;
+        }
+
+        c = next_char(tokenizer);
+        char decoded = 0;
+        switch (c)
+        {
+        case '"':
+        case '\\':
+        case '/':
+            decoded = (char)c;
+            break;
+        case 'b':
+            decoded = '\b';
+            break;
+        case 'f':
+            decoded = '\f';
+            break;
+        case 'n':
+            decoded = '\n';
+            break;
+        case 'r':
+            decoded = '\r';
+            break;
+        case 't':
+            decoded = '\t';
+            break;
+        case 'u':
+        {
+            uint32_t code_point = 0;
+            if (!read_hex4(tokenizer, &code_point))
+            {
+                return set_error(tokenizer, "invalid \\u escape");
+            }
+            // Surrogate pair
+            if (code_point >= 0xD800 && code_point <= 0xDBFF)
+            {
+                uint32_t low = 0;
+                if (next_char(tokenizer) != '\\' || next_char(tokenizer) != 'u' || !read_hex4(tokenizer, &low) || low < 0xDC00 || low > 0xDFFF)
+                {
+                    return set_error(tokenizer, "invalid surrogate pair");
+                }
+                code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+            }
+            if (!append_utf8(tokenizer, code_point))
+            {
+                return set_error(tokenizer, "out of memory");
+            }
+            continue;
+        }
+        default:
+            return set_error(tokenizer, "invalid escape sequence");
+        }
+        if (!append_text(tokenizer, decoded))
+        {
+            return set_error(tokenizer, "out of memory");
+        }
+    }
+}
+
+static JsonTokenType read_number(JsonTokenizer *tokenizer)
+{
+    tokenizer->text_length = 0;
+    tokenizer->text[0] = '\0';
+    tokenizer->is_integer = true;
+    while (true)
+    {
+        int c = peek_char(tokenizer);
+        if (c == '.' || c == 'e' || c == 'E')
+        {
+            tokenizer->is_integer = false;
+        }
+        else if (!((c >= '0' && c <= '9') || c == '-' || c == '+'))
+        {
+            break;
+        }
+        if (!append_text(tokenizer, (char)c))
+        {
+            return set_error(tokenizer, "out of memory");
+        }
+        tokenizer->position++;
+    }
+
+    char *end = NULL;
+    tokenizer->number = strtod(tokenizer->text, &end);
+    if (tokenizer->text_length == 0 || *end != '\0')
+    {
+        return set_error(tokenizer, "invalid number '%s'", tokenizer->text);
+    }
+    if (tokenizer->is_integer)
+    {
+        errno = 0;
+        tokenizer->integer = strtoll(tokenizer->text, NULL, 10);
+        if (errno == ERANGE)
+        {
+            tokenizer->is_integer = false;
+        }
+    }
+    return JSON_TOKEN_NUMBER;
+}
+
+static JsonTokenType read_literal(JsonTokenizer *tokenizer, const char *literal, JsonTokenType type)
+{
+    for (const char *expected = literal; *expected != '\0'; expected++)
+    {
+        if (next_char(tokenizer) != *expected)
+        {
+            return set_error(tokenizer, "invalid literal, expected '%s'", literal);
+        }
+    }
+    return type;
+}
+
+static void finish_value(JsonTokenizer *tokenizer)
+{
+    tokenizer->state = tokenizer->depth == 0 ? EXPECT_NOTHING : EXPECT_COMMA_OR_END;
+}
+
+static JsonTokenType begin_container(JsonTokenizer *tokenizer, char container)
+{
+    if (tokenizer->depth >= JSON_TOKENIZER_MAX_DEPTH)
+    {
+        return set_error(tokenizer, "nesting deeper than %d", JSON_TOKENIZER_MAX_DEPTH);
+    }
+    tokenizer->position++;
+    tokenizer->containers[tokenizer->depth++] = container;
+    if (container == '{')
+    {
+        tokenizer->state = EXPECT_KEY_OR_END;
+        return JSON_TOKEN_BEGIN_OBJECT;
+    }
+    tokenizer->state = EXPECT_VALUE_OR_END;
+    return JSON_TOKEN_BEGIN_ARRAY;
+}
+
+static JsonTokenType end_container(JsonTokenizer *tokenizer, int c)
+{
+    char expected = c == '}' ? '{' : '[';
+    if (tokenizer->depth == 0 || tokenizer->containers[tokenizer->depth - 1] != expected)
+    {
+        return set_error(tokenizer, "unexpected '%c'", c);
+    }
+    tokenizer->position++;
+    tokenizer->depth--;
+    finish_value(tokenizer);
+    return c == '}' ? JSON_TOKEN_END_OBJECT : JSON_TOKEN_END_ARRAY;
+}
+
+static JsonTokenType read_value(JsonTokenizer *tokenizer, int c)
+{
+    JsonTokenType type = JSON_TOKEN_ERROR;
+    if (c == '{' || c == '[')
+    {
+        return begin_container(tokenizer, (char)c);
+    }
+    if (c == '"')
+    {
+        tokenizer->position++;
+        type = read_string(tokenizer, JSON_TOKEN_STRING);
+    }
+    else if (c == '-' || (c >= '0' && c <= '9'))
+    {
+        type = read_number(tokenizer);
+    }
+    else if (c == 't')
+    {
+        type = read_literal(tokenizer, "true", JSON_TOKEN_TRUE);
+    }
+    else if (c == 'f')
+    {
+        type = read_literal(tokenizer, "false", JSON_TOKEN_FALSE);
+    }
+    else if (c == 'n')
+    {
+        type = read_literal(tokenizer, "null", JSON_TOKEN_NULL);
+    }
+    else if (c == -1)
+    {
+        return set_error(tokenizer, "unexpected end of input");
+    }
+    else
+    {
+        return set_error(tokenizer, "unexpected character '%c'", c);
+    }
+
+    if (type != JSON_TOKEN_ERROR)
+    {
+        finish_value(tokenizer);
+    }
+    return type;
+}
+
+static JsonTokenType read_key(JsonTokenizer *tokenizer, int c)
+{
+    if (c != '"')
+    {
+        return c == -1 ? set_error(tokenizer, "unexpected end of input") : set_error(tokenizer, "expected a key, got '%c'", c);
+    }
+    tokenizer->position++;
+    if (read_string(tokenizer, JSON_TOKEN_KEY) == JSON_TOKEN_ERROR)
+    {
+        return JSON_TOKEN_ERROR;
+    }
+    tokenizer->key_hash = json_key_hash(tokenizer->text, tokenizer->text_length);
+    skip_whitespace(tokenizer);
+    if (next_char(tokenizer) != ':')
+    {
+        return set_error(tokenizer, "expected ':' after key \"%s\"", tokenizer->text);
+    }
+    tokenizer->state = EXPECT_VALUE;
+    return JSON_TOKEN_KEY;
+}
+
+JsonTokenType json_tokenizer_next(JsonTokenizer *tokenizer)
+{
+    if (tokenizer->error[0] != '\0')
+    {
+        return JSON_TOKEN_ERROR;
+    }
+    skip_whitespace(tokenizer);
+    int c = peek_char(tokenizer);
+
+    switch (tokenizer->state)
+    {
+    case EXPECT_VALUE:
+        return read_value(tokenizer, c);
+    case EXPECT_VALUE_OR_END:
+        if (c == ']')
+        {
+            return end_container(tokenizer, c);
+        }
+        return read_value(tokenizer, c);
+    case EXPECT_KEY:
+        return read_key(tokenizer, c);
+    case EXPECT_KEY_OR_END:
+        if (c == '}')
+        {
+            return end_container(tokenizer, c);
+        }
+        return read_key(tokenizer, c);
+    case EXPECT_COMMA_OR_END:
+        if (c == '}' || c == ']')
+        {
+            return end_container(tokenizer, c);
+        }
+        if (c != ',')
+        {
+            return c == -1 ? set_error(tokenizer, "unexpected end of input") : set_error(tokenizer, "expected ',' or end of container, got '%c'", c);
+        }
+        tokenizer->position++;
+        skip_whitespace(tokenizer);
+        c = peek_char(tokenizer);
+        if (tokenizer->containers[tokenizer->depth - 1] == '{')
+        {
+            return read_key(tokenizer, c);
+        }
+        return read_value(tokenizer, c);
+    default:
+        if (c != -1)
+        {
+            return set_error(tokenizer, "unexpected data after the end of the document");
+        }
+        return JSON_TOKEN_END;
+    }
+}
+
+int json_tokenizer_skip_value(JsonTokenizer *tokenizer)
+{
+    int depth = 0;
+    do
+    {
+        JsonTokenType type = json_tokenizer_next(tokenizer);
+        switch (type)
+        {
+        case JSON_TOKEN_BEGIN_OBJECT:
+        case JSON_TOKEN_BEGIN_ARRAY:
+            depth++;
+            break;
+        case JSON_TOKEN_END_OBJECT:
+        case JSON_TOKEN_END_ARRAY:
+            depth--;
+            break;
+        case JSON_TOKEN_ERROR:
+        case JSON_TOKEN_END:
+            return 0;
+        default:
+            break;
+        }
+    } while (depth > 0);
+    return 1;
+}
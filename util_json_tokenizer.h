@@ -0,0 +1,72 @@
+#ifndef UTIL_JSON_TOKENIZER_H
+#define UTIL_JSON_TOKENIZER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define JSON_TOKENIZER_CHUNK_SIZE (64 * 1024)
+#define JSON_TOKENIZER_MAX_DEPTH 64
+#define JSON_TOKENIZER_ERROR_LENGTH 160
+
+typedef enum
+{
+    JSON_TOKEN_BEGIN_OBJECT,
+    JSON_TOKEN_END_OBJECT,
+    JSON_TOKEN_BEGIN_ARRAY,
+    JSON_TOKEN_END_ARRAY,
+    JSON_TOKEN_KEY,
+    JSON_TOKEN_STRING,
+    JSON_TOKEN_NUMBER,
+    JSON_TOKEN_TRUE,
+    JSON_TOKEN_FALSE,
+    JSON_TOKEN_NULL,
+    JSON_TOKEN_END,
+    JSON_TOKEN_ERROR,
+} JsonTokenType;
+
+// Pull tokenizer: the input is read in chunks (or used in place for mapped files and memory buffers)
+// and only the current token is kept, so memory does not grow with the document.
+// Structure is validated as tokens are produced; keys come as JSON_TOKEN_KEY with the ':' consumed.
+typedef struct
+{
+    int fd;
+    _Bool owns_fd;
+    const char *data;
+    size_t length;
+    size_t position;
+    char *read_buffer;
+    // Non-zero when [data] is the whole file mapped with mmap
+    size_t mapped_size;
+    _Bool is_eof;
+
+    // Text of the current KEY, STRING or NUMBER token, '\0'-terminated, escapes decoded
+    char *text;
+    size_t text_length;
+    size_t text_capacity;
+    double number;
+    int64_t integer;
+    _Bool is_integer;
+    // json_key_hash of [text], set for KEY tokens
+    uint32_t key_hash;
+
+    int depth;
+    char containers[JSON_TOKENIZER_MAX_DEPTH];
+    int state;
+    int line;
+    char error[JSON_TOKENIZER_ERROR_LENGTH];
+} JsonTokenizer;
+
+// Regular files are memory-mapped (MAP_PRIVATE, MADV_SEQUENTIAL), anything else is read in chunks.
+// Path "-" reads stdin. Nothing is printed: on failure it returns NULL with errno set.
+JsonTokenizer *json_tokenizer_open(const char *path);
+// [data] must outlive the tokenizer, it is not copied
+JsonTokenizer *json_tokenizer_open_buffer(const char *data, size_t size);
+JsonTokenType json_tokenizer_next(JsonTokenizer *tokenizer);
+// Skips the next value, including everything nested in it; 0 on error
+int json_tokenizer_skip_value(JsonTokenizer *tokenizer);
+void json_tokenizer_close(JsonTokenizer **tokenizer);
+// FNV-1a, for dispatching keys through tables hashed up front
+uint32_t json_key_hash(const char *key, size_t length);
+
+#endif
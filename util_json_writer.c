@@ -0,0 +1,193 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "util_json_writer.h"
+
+#define JSON_INDENT "    "
+
+static void write_bytes(JsonWriter *json_writer, const char *bytes, size_t size)
+{
+    buffered_writer_write(json_writer->writer, bytes, size);
+}
+
+static void write_text(JsonWriter *json_writer, const char *text)
+{
+    write_bytes(json_writer, text, strlen(text));
+}
+
+static void write_new_line(JsonWriter *json_writer)
+{
+    write_bytes(json_writer, "\n", 1);
+    for (int i = 0; i < json_writer->depth; i++)
+    {
+        write_bytes(json_writer, JSON_INDENT, sizeof(JSON_INDENT) - 1);
+    }
+}
+
+static void write_escaped_string(JsonWriter *json_writer, const char *value)
+{
+    write_bytes(json_writer, "\"", 1);
+    const char *start = value;
+    for (const char *cursor = value; *cursor != '\0'; cursor++)
+    {
+        unsigned char symbol = (unsigned char)*cursor;
+        if (symbol != '"' && symbol != '\\' && symbol >= 0x20)
+        {
+            continue;
+        }
+        write_bytes(json_writer, start, (size_t)(cursor - start));
+        char escaped[8];
+        int length = 0;
+        if (symbol == '"' || symbol == '\\')
+        {
+            length = snprintf(escaped, sizeof(escaped), "\\%c", symbol);
+        }
+        else
+        {
+            length = snprintf(escaped, sizeof(escaped), "\\u%04x", symbol);
+        }
+        write_bytes(json_writer, escaped, (size_t)length);
+        start = cursor + 1;
+    }
+    write_text(json_writer, start);
+    write_bytes(json_writer, "\"", 1);
+}
+
+// Comma, line break and "key": in front of every value
+static void write_value_prefix(JsonWriter *json_writer, const char *key)
+{
+    if (json_writer->depth > 0)
+    {
+        if (json_writer->has_items[json_writer->depth])
+        {
+            write_bytes(json_writer, ",", 1);
+        }
+        json_writer->has_items[json_writer->depth] = true;
+        write_new_line(json_writer);
+    }
+    if (key != NULL)
+    {
+        write_escaped_string(json_writer, key);
+        write_bytes(json_writer, ": ", 2);
+    }
+}
+
+static void begin_container(JsonWriter *json_writer, const char *key, const char *bracket)
+{
+    write_value_prefix(json_writer, key);
+    write_text(json_writer, bracket);
+    if (json_writer->depth + 1 < JSON_WRITER_MAX_DEPTH)
+    {
+        json_writer->depth++;
+        json_writer->has_items[json_writer->depth] = false;
+    }
+}
+
+static void end_container(JsonWriter *json_writer, const char *bracket)
+{
+    _Bool has_items = json_writer->has_items[json_writer->depth];
+    if (json_writer->depth > 0)
+    {
+        json_writer->depth--;
+    }
+    if (has_items)
+    {
+        write_new_line(json_writer);
+    }
+    write_text(json_writer, bracket);
+}
+
+JsonWriter *json_writer_open(const char *path)
+{
+    JsonWriter *json_writer = (JsonWriter *)malloc(sizeof(JsonWriter));
+    if (json_writer == NULL)
+    {
+        printf("❌ Unable to allocate memory for JSON writer.\n");
+        return NULL;
+    }
+    json_writer->writer = buffered_writer_open(path, 0);
+    if (json_writer->writer == NULL)
+    {
+        free(json_writer);
+        return NULL;
+    }
+    json_writer->depth = 0;
+    json_writer->has_items[0] = false;
+    return json_writer;
+}
+
+void json_writer_begin_object(JsonWriter *json_writer, const char *key)
+{
+    begin_container(json_writer, key, "{");
+}
+
+void json_writer_end_object(JsonWriter *json_writer)
+{
+    end_container(json_writer, "}");
+}
+
+void json_writer_begin_array(JsonWriter *json_writer, const char *key)
+{
+    begin_container(json_writer, key, "[");
+}
+
+void json_writer_end_array(JsonWriter *json_writer)
+{
+    end_container(json_writer, "]");
+}
+
+void json_writer_write_int(JsonWriter *json_writer, const char *key, int64_t value)
+{
+    char digits[24];
+    write_value_prefix(json_writer, key);
+    write_bytes(json_writer, digits, (size_t)(format_int64(digits, value) - digits));
+}
+
+void json_writer_write_double(JsonWriter *json_writer, const char *key, double value)
+{
+    write_value_prefix(json_writer, key);
+    if (!isfinite(value))
+    {
+        write_bytes(json_writer, "null", 4);
+        return;
+    }
+    // Whole numbers (the common case for seconds and liters) skip printf.
+    // The range check comes first, casting a double outside int64 is undefined.
+    if (fabs(value) < 1e15 && value == (double)(int64_t)value)
+    {
+        char digits[24];
+        write_bytes(json_writer, digits, (size_t)(format_int64(digits, (int64_t)value) - digits));
+        return;
+    }
+    // 17 significant digits round-trip every double
+    char number[32];
+    int length = snprintf(number, sizeof(number), "%.17g", value);
+    write_bytes(json_writer, number, (size_t)length);
+}
+
+void json_writer_write_string(JsonWriter *json_writer, const char *key, const char *value)
+{
+    write_value_prefix(json_writer, key);
+    write_escaped_string(json_writer, value);
+}
+
+void json_writer_write_bool(JsonWriter *json_writer, const char *key, _Bool value)
+{
+    write_value_prefix(json_writer, key);
+    write_text(json_writer, value ? "true" : "false");
+}
+
+int json_writer_close(JsonWriter **json_writer)
+{
+    if ((*json_writer) == NULL)
+    {
+        return 1;
+    }
+    write_bytes((*json_writer), "\n", 1);
+    int result = buffered_writer_close(&(*json_writer)->writer);
+    free((*json_writer));
+    (*json_writer) = NULL;
+    return result;
+}
@@ -0,0 +1,31 @@
+#ifndef UTIL_JSON_WRITER_H
+#define UTIL_JSON_WRITER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "util_buffered_writer.h"
+
+#define JSON_WRITER_MAX_DEPTH 16
+
+// Streaming JSON writer: values go straight into a BufferedWriter, only the nesting state is kept.
+// [key] is the member name inside objects and NULL inside arrays or for the root value.
+typedef struct
+{
+    BufferedWriter *writer;
+    int depth;
+    _Bool has_items[JSON_WRITER_MAX_DEPTH];
+} JsonWriter;
+
+JsonWriter *json_writer_open(const char *path);
+void json_writer_begin_object(JsonWriter *json_writer, const char *key);
+void json_writer_end_object(JsonWriter *json_writer);
+void json_writer_begin_array(JsonWriter *json_writer, const char *key);
+void json_writer_end_array(JsonWriter *json_writer);
+void json_writer_write_int(JsonWriter *json_writer, const char *key, int64_t value);
+void json_writer_write_double(JsonWriter *json_writer, const char *key, double value);
+void json_writer_write_string(JsonWriter *json_writer, const char *key, const char *value);
+void json_writer_write_bool(JsonWriter *json_writer, const char *key, _Bool value);
+int json_writer_close(JsonWriter **json_writer);
+
+#endif
@@ -0,0 +1,135 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "util_live_stats.h"
+
+static LiveStatistics *live_stats = NULL;
+static size_t segment_size = 0;
+static char segment_name[64] = "";
+
+size_t live_stats_get_size(int fuel_pumps_count)
+{
+    return sizeof(LiveStatistics) + (size_t)fuel_pumps_count * sizeof(LivePumpState);
+}
+
+int live_stats_open(int fuel_pumps_count, int64_t start_time_unix)
+{
+    segment_size = live_stats_get_size(fuel_pumps_count);
+    snprintf(segment_name, sizeof(segment_name), "/" LIVE_STATS_NAME_PREFIX "%d", (int)getpid());
+    int fd = shm_open(segment_name, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        printf("❌ Unable to create shared memory '%s': %s\n", segment_name, strerror(errno));
+        segment_name[0] = '\0';
+        return 0;
+    }
+    if (ftruncate(fd, (off_t)segment_size) != 0)
+    {
+        printf("❌ Unable to resize shared memory '%s': %s\n", segment_name, strerror(errno));
+        close(fd);
+        live_stats_close();
+        return 0;
+    }
+    void *data = mmap(NULL, segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        printf("❌ Unable to map shared memory '%s': %s\n", segment_name, strerror(errno));
+        live_stats_close();
+        return 0;
+    }
+
+    // ftruncate already zeroed the segment
+    live_stats = (LiveStatistics *)data;
+    live_stats->version = LIVE_STATS_VERSION;
+    live_stats->size = segment_size;
+    live_stats->pid = (int32_t)getpid();
+    live_stats->fuel_pumps_count = fuel_pumps_count;
+    live_stats->start_time_unix = start_time_unix;
+    for (int i = 0; i < fuel_pumps_count; i++)
+    {
+        live_stats->pumps[i].vehicle_id = -1;
+    }
+    atomic_init(&live_stats->sequence, 0);
+    // The magic goes last, readers skip the segment until it is there
+    atomic_thread_fence(memory_order_release);
+    memcpy(live_stats->magic, LIVE_STATS_MAGIC, sizeof(LIVE_STATS_MAGIC));
+    return 1;
+}
+
+LiveStatistics *live_stats_begin_update()
+{
+    if (live_stats == NULL)
+    {
+        return NULL;
+    }
+    unsigned int sequence = atomic_load_explicit(&live_stats->sequence, memory_order_relaxed);
+    atomic_store_explicit(&live_stats->sequence, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    return live_stats;
+}
+
+void live_stats_end_update(LiveStatistics *updated)
+{
+    unsigned int sequence = atomic_load_explicit(&updated->sequence, memory_order_relaxed);
+    atomic_store_explicit(&updated->sequence, sequence + 1, memory_order_release);
+}
+
+void live_stats_close()
+{
+    if (live_stats != NULL)
+    {
+        LiveStatistics *updated = live_stats_begin_update();
+        updated->is_finished = 1;
+        live_stats_end_update(updated);
+        munmap(live_stats, segment_size);
+        live_stats = NULL;
+    }
+    if (segment_name[0] != '\0')
+    {
+        shm_unlink(segment_name);
+        segment_name[0] = '\0';
+    }
+}
+
+LiveStatistics *live_stats_read(const LiveStatistics *shared, size_t mapped_size)
+{
+    if (mapped_size < sizeof(LiveStatistics) ||
+        memcmp(shared->magic, LIVE_STATS_MAGIC, sizeof(LIVE_STATS_MAGIC)) != 0 ||
+        shared->version != LIVE_STATS_VERSION ||
+        shared->fuel_pumps_count < 0 ||
+        shared->size != mapped_size ||
+        shared->size != live_stats_get_size(shared->fuel_pumps_count))
+    {
+        return NULL;
+    }
+    LiveStatistics *copy = (LiveStatistics *)malloc(mapped_size);
+    if (copy == NULL)
+    {
+        return NULL;
+    }
+
+    // A writer killed in the middle of an update leaves [sequence] odd forever, so give up eventually
+    for (int attempt = 0; attempt < LIVE_STATS_READ_ATTEMPTS; attempt++)
+    {
+        unsigned int before = atomic_load_explicit((atomic_uint *)&shared->sequence, memory_order_acquire);
+        if (before & 1)
+        {
+            continue;
+        }
+        memcpy(copy, shared, mapped_size);
+        atomic_thread_fence(memory_order_acquire);
+        unsigned int after = atomic_load_explicit((atomic_uint *)&shared->sequence, memory_order_relaxed);
+        if (before == after)
+        {
+            return copy;
+        }
+    }
+    free(copy);
+    return NULL;
+}
@@ -0,0 +1,59 @@
+#ifndef UTIL_LIVE_STATS_H
+#define UTIL_LIVE_STATS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+#include "util_vehicle_type.h"
+#include "util_snapshot.h"
+
+// Live statistics in POSIX shared memory (`--live`), one segment per process: /dev/shm/gas_station.<pid>.
+// The simulator is the only writer; readers copy the struct and retry while [sequence] is odd or changed,
+// so they never make the simulator wait. Bump LIVE_STATS_VERSION on any layout change.
+// The segment is sized for the run: the fixed part followed by one LivePumpState per pump.
+#define LIVE_STATS_MAGIC "GSLIVE"
+#define LIVE_STATS_VERSION 3
+#define LIVE_STATS_NAME_PREFIX "gas_station."
+#define LIVE_STATS_READ_ATTEMPTS 100000
+
+typedef struct
+{
+    // Car number on the pump, -1 when the pump is free
+    int32_t vehicle_id;
+    int32_t vehicles_serviced;
+} LivePumpState;
+
+typedef struct
+{
+    char magic[8];
+    uint32_t version;
+    // Whole segment, pumps included
+    uint64_t size;
+    int32_t pid;
+    int32_t fuel_pumps_count;
+    int64_t start_time_unix;
+
+    atomic_uint sequence;
+    uint32_t is_finished;
+    uint64_t elapsed_ns;
+    StationState station;
+    int64_t vehicles_serviced[VEHICLE_NOT_FOUND];
+    int64_t vehicles_left_without_fuel[VEHICLE_NOT_FOUND];
+    LivePumpState pumps[];
+} LiveStatistics;
+
+size_t live_stats_get_size(int fuel_pumps_count);
+
+int live_stats_open(int fuel_pumps_count, int64_t start_time_unix);
+// Returns the shared struct to fill in, NULL when live statistics are off. Single writer only.
+LiveStatistics *live_stats_begin_update();
+void live_stats_end_update(LiveStatistics *live_stats);
+// Marks the run as finished and removes the segment
+void live_stats_close();
+
+// Consistent copy of a segment mapped with [mapped_size] bytes, free() it when done;
+// NULL when it is not a supported live statistics segment or never settles
+LiveStatistics *live_stats_read(const LiveStatistics *shared, size_t mapped_size);
+
+#endif
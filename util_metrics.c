@@ -0,0 +1,308 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include "util_metrics.h"
+#include "util_snapshot.h"
+
+// Upper bounds of the exported wait-time buckets, in seconds
+static const double wait_time_buckets_sec[] = {0.001, 0.01, 0.1, 0.5, 1, 2, 5, 10, 30, 60, 300};
+static const VehicleType vehicle_types[] = {VEHICLE_AUTO, VEHICLE_TRUCK, VEHICLE_VAN};
+
+static int listen_fd = -1;
+static char unix_socket_path[sizeof(((struct sockaddr_un *)0)->sun_path)] = "";
+static pthread_t metrics_thread;
+static _Bool is_running = false;
+
+static const StatisticsShard *statistics_shards = NULL;
+static int statistics_shards_count = 0;
+
+// Only the server thread touches the response buffer
+static char response[METRICS_RESPONSE_CAPACITY];
+static size_t response_length = 0;
+
+static void append(const char *format, ...)
+{
+    if (response_length >= sizeof(response))
+    {
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(response + response_length, sizeof(response) - response_length, format, args);
+    va_end(args);
+    if (written > 0)
+    {
+        response_length += (size_t)written;
+        if (response_length > sizeof(response))
+        {
+            response_length = sizeof(response);
+        }
+    }
+}
+
+static void append_header(const char *name, const char *type, const char *help)
+{
+    append("# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+}
+
+static void build_metrics()
+{
+    StationState state;
+    station_snapshot_read(&state);
+    VehicleStatistics per_type[VEHICLE_NOT_FOUND];
+    statistics_shards_merge(statistics_shards, statistics_shards_count, per_type);
+    const int vehicle_types_count = sizeof(vehicle_types) / sizeof(vehicle_types[0]);
+
+    response_length = 0;
+    append_header("gas_station_vehicles_serviced_total", "counter", "Vehicles that left with fuel.");
+    for (int i = 0; i < vehicle_types_count; i++)
+    {
+        append("gas_station_vehicles_serviced_total{vehicle_type=\"%s\"} %lld\n",
+               get_vehicle_type_name(vehicle_types[i]), (long long)per_type[vehicle_types[i]].serviced);
+    }
+    append_header("gas_station_vehicles_left_without_fuel_total", "counter", "Vehicles that left without fuel.");
+    for (int i = 0; i < vehicle_types_count; i++)
+    {
+        append("gas_station_vehicles_left_without_fuel_total{vehicle_type=\"%s\"} %lld\n",
+               get_vehicle_type_name(vehicle_types[i]), (long long)per_type[vehicle_types[i]].unserviced);
+    }
+
+    append_header("gas_station_fuel_storage_liters", "gauge", "Fuel in the station storage.");
+    append("gas_station_fuel_storage_liters %lld\n", (long long)state.fuel_storage);
+    append_header("gas_station_tanker_fuel_left_liters", "gauge", "Fuel not yet delivered by tankers.");
+    append("gas_station_tanker_fuel_left_liters %lld\n", (long long)state.fuel_left);
+    append_header("gas_station_tanker_deliveries_total", "counter", "Tanker deliveries into the storage.");
+    append("gas_station_tanker_deliveries_total %d\n", state.fuel_deliveries);
+    append_header("gas_station_fuel_pumps", "gauge", "Fuel pumps at the station.");
+    append("gas_station_fuel_pumps %d\n", statistics_shards_count);
+    append_header("gas_station_fuel_pumps_occupied", "gauge", "Fuel pumps occupied by a vehicle.");
+    append("gas_station_fuel_pumps_occupied %d\n", state.occupied_pumps);
+    append_header("gas_station_cars_waiting_for_pump", "gauge", "Vehicles queued for a free pump.");
+    append("gas_station_cars_waiting_for_pump %d\n", state.cars_waiting_for_pump);
+    append_header("gas_station_cars_waiting_for_fuel", "gauge", "Vehicles at a pump waiting for a delivery.");
+    append("gas_station_cars_waiting_for_fuel %d\n", state.cars_waiting_for_fuel);
+
+    append_header("gas_station_wait_time_seconds", "histogram", "Time from taking a pump to leaving it.");
+    for (int i = 0; i < vehicle_types_count; i++)
+    {
+        const VehicleStatistics *statistics = &per_type[vehicle_types[i]];
+        const char *name = get_vehicle_type_name(vehicle_types[i]);
+        for (size_t j = 0; j < sizeof(wait_time_buckets_sec) / sizeof(wait_time_buckets_sec[0]); j++)
+        {
+            uint64_t count = histogram_count_at_or_below(&statistics->wait_time, (uint64_t)(wait_time_buckets_sec[j] * 1e6));
+            append("gas_station_wait_time_seconds_bucket{vehicle_type=\"%s\",le=\"%g\"} %llu\n", name, wait_time_buckets_sec[j], (unsigned long long)count);
+        }
+        append("gas_station_wait_time_seconds_bucket{vehicle_type=\"%s\",le=\"+Inf\"} %llu\n", name, (unsigned long long)statistics->wait_time.count);
+        append("gas_station_wait_time_seconds_sum{vehicle_type=\"%s\"} %.6f\n", name, statistics->wait_time_ns / 1e9);
+        append("gas_station_wait_time_seconds_count{vehicle_type=\"%s\"} %llu\n", name, (unsigned long long)statistics->wait_time.count);
+    }
+}
+
+static void send_all(int fd, const char *bytes, size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t written = send(fd, bytes, size, MSG_NOSIGNAL);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return;
+        }
+        bytes += written;
+        size -= (size_t)written;
+    }
+}
+
+static void serve_client(int client_fd)
+{
+    // The request itself does not matter, read it so the client does not see a reset
+    char request[1024];
+    if (recv(client_fd, request, sizeof(request), 0) < 0)
+    {
+        return;
+    }
+
+    build_metrics();
+    char header[160];
+    int header_length = snprintf(header, sizeof(header),
+                                 "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: %zu\r\nConnection: close\r\n\r\n",
+                                 response_length);
+    send_all(client_fd, header, (size_t)header_length);
+    send_all(client_fd, response, response_length);
+}
+
+static void *metrics_server(void *thread_data)
+{
+    (void)thread_data;
+    while (true)
+    {
+        int client_fd = accept(listen_fd, NULL, NULL);
+        if (client_fd < 0)
+        {
+            if (errno == EINTR || errno == ECONNABORTED)
+            {
+                continue;
+            }
+            // metrics_server_stop() shuts the listening socket down
+            break;
+        }
+        // A client that never sends its request must not stall the next scrape
+        struct timeval timeout = {1, 0};
+        setsockopt(client_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        setsockopt(client_fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        serve_client(client_fd);
+        close(client_fd);
+    }
+    return NULL;
+}
+
+static int open_unix_socket(const char *path)
+{
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(address.sun_path))
+    {
+        printf("❌ [--metrics]: Socket path '%s' is too long.\n", path);
+        return -1;
+    }
+    strcpy(address.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        printf("❌ Unable to create metrics socket: %s\n", strerror(errno));
+        return -1;
+    }
+    // A stale socket from a previous run would make bind fail
+    unlink(path);
+    if (bind(fd, (struct sockaddr *)&address, sizeof(address)) != 0)
+    {
+        printf("❌ Unable to bind metrics socket '%s': %s\n", path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    strcpy(unix_socket_path, path);
+    return fd;
+}
+
+static int open_tcp_socket(const char *address_text)
+{
+    char host[64] = "127.0.0.1";
+    const char *port_text = address_text;
+    const char *separator = strrchr(address_text, ':');
+    if (separator != NULL)
+    {
+        size_t host_length = (size_t)(separator - address_text);
+        if (host_length == 0 || host_length >= sizeof(host))
+        {
+            printf("❌ [--metrics]: Invalid address '%s'.\n", address_text);
+            return -1;
+        }
+        memcpy(host, address_text, host_length);
+        host[host_length] = '\0';
+        port_text = separator + 1;
+    }
+    if (strcmp(host, "localhost") == 0)
+    {
+        strcpy(host, "127.0.0.1");
+    }
+
+    char *end = NULL;
+    long port = strtol(port_text, &end, 10);
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons((uint16_t)port);
+    if (*port_text == '\0' || *end != '\0' || port <= 0 || port > 65535 || inet_pton(AF_INET, host, &address.sin_addr) != 1)
+    {
+        printf("❌ [--metrics]: Invalid address '%s'.\n", address_text);
+        return -1;
+    }
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        printf("❌ Unable to create metrics socket: %s\n", strerror(errno));
+        return -1;
+    }
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    if (bind(fd, (struct sockaddr *)&address, sizeof(address)) != 0)
+    {
+        printf("❌ Unable to bind metrics socket '%s': %s\n", address_text, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int metrics_server_start(const char *address, const StatisticsShard *shards, int shards_count)
+{
+    statistics_shards = shards;
+    statistics_shards_count = shards_count;
+
+    if (strncmp(address, "unix:", 5) == 0)
+    {
+        listen_fd = open_unix_socket(address + 5);
+    }
+    else
+    {
+        listen_fd = open_tcp_socket(address);
+    }
+    if (listen_fd < 0)
+    {
+        return 0;
+    }
+    if (listen(listen_fd, 8) != 0)
+    {
+        printf("❌ Unable to listen for metrics on '%s': %s\n", address, strerror(errno));
+        metrics_server_stop();
+        return 0;
+    }
+
+    if (pthread_create(&metrics_thread, NULL, metrics_server, NULL) != 0)
+    {
+        printf("❌ Error: pthread_create for metrics server\n");
+        metrics_server_stop();
+        return 0;
+    }
+    is_running = true;
+    return 1;
+}
+
+void metrics_server_stop()
+{
+    if (listen_fd >= 0)
+    {
+        shutdown(listen_fd, SHUT_RDWR);
+    }
+    if (is_running)
+    {
+        pthread_join(metrics_thread, NULL);
+        is_running = false;
+    }
+    if (listen_fd >= 0)
+    {
+        close(listen_fd);
+        listen_fd = -1;
+    }
+    if (unix_socket_path[0] != '\0')
+    {
+        unlink(unix_socket_path);
+        unix_socket_path[0] = '\0';
+    }
+}
@@ -0,0 +1,14 @@
+#ifndef UTIL_METRICS_H
+#define UTIL_METRICS_H
+
+#include "util_statistics.h"
+
+#define METRICS_RESPONSE_CAPACITY (64 * 1024)
+
+// Prometheus text endpoint (`--metrics 9464` or `--metrics unix:/tmp/gas_station.sock`).
+// TCP addresses are "[host:]port" and default to 127.0.0.1. Every request gets the same plain
+// HTTP/1.0 response, built from the station snapshot and the statistics shards, so a scrape never takes `dynamic_lock`.
+int metrics_server_start(const char *address, const StatisticsShard *shards, int shards_count);
+void metrics_server_stop();
+
+#endif
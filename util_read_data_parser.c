@@ -4,19 +4,152 @@
 #include <string.h>
 #include <time.h>
 #include <stdbool.h>
-
-#include "cjson/cJSON.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <errno.h>
+#include <stdarg.h>
+#include <pthread.h>
+
+#include "util_json_tokenizer.h"
 #include "util_read_data_parser.h"
 
+// print_json_result lists every vehicle of a run up to this size, a network-scale run only gets the summary
+#define PRINTED_VEHICLES_LIMIT 1000
+
+// Leading mark of every error message, not part of ReadDataParserResult.error
+#define PARSER_ERROR_MARK "❌ "
+
+// Custom list values that fall back to the entry defaults, which may come after the list.
+// Valid values are > 0 and >= -1, so they can not collide.
+#define FUEL_NEEDED_FROM_DEFAULT 0
+#define WAIT_TIME_FROM_DEFAULT INT_MIN
+
+// Scalar member of a JSON object as far as the parser has seen it.
+// A repeated key keeps the first value, like cJSON_GetObjectItem did.
+typedef struct
+{
+    StatusType status;
+    int64_t value;
+} IntField;
+
+typedef struct
+{
+    StatusType status;
+    _Bool value;
+} BoolField;
+
+typedef struct
+{
+    IntField fuel_pumps_count;
+    IntField max_vehicle_capacity;
+    IntField initial_fuel_in_tanker;
+    IntField fuel_transfer_rate;
+    BoolField randomize_arrival;
+    StatusType vehicles_status;
+} ScenarioFields;
+
+// One element of [vehicles]. Its custom list groups are emitted while the list is read
+// and dropped again if the entry turns out to be invalid once the object ends.
+typedef struct
+{
+    StatusType vehicle_type_status;
+    VehicleType vehicle_type;
+    IntField default_fuel_needed;
+    IntField default_wait_time_sec;
+    IntField default_count;
+    StatusType custom_waiting_list_status;
+    int first_group_index;
+    int64_t first_vehicle_index;
+    _Bool is_header_logged;
+    _Bool is_header_valid;
+} VehicleEntry;
+
+typedef struct
+{
+    IntField fuel_needed;
+    IntField wait_time_sec;
+    IntField count;
+} CustomItemFields;
+
+typedef enum
+{
+    FIELD_INT,
+    FIELD_BOOL,
+    FIELD_VEHICLE_TYPE,
+    FIELD_VEHICLES,
+    FIELD_CUSTOM_WAITING_LIST,
+} FieldKind;
+
+// Known member of an object: how to read it and where its IntField / BoolField lives in the fields struct
+typedef struct
+{
+    const char *key;
+    FieldKind kind;
+    size_t offset;
+    uint32_t key_hash;
+} FieldDescriptor;
+
+// Power of two, at least twice the largest table so probes stay short
+#define FIELD_TABLE_SLOTS 16
+
+// Keys are looked up by the hash the tokenizer computes, with one strcmp to confirm
+typedef struct
+{
+    FieldDescriptor *fields;
+    int fields_count;
+    // Index + 1 into [fields], 0 for an empty slot; open addressing with linear probing
+    unsigned char slots[FIELD_TABLE_SLOTS];
+} FieldTable;
+
 // ============
 
 //
 
 // ============
 
-static _Bool SHOW_LOGS = false;
-static char *buffer = NULL;
-static cJSON *json = NULL;
+// Parser state is per thread, so a batch can validate files in parallel; the limits are shared
+static _Thread_local _Bool SHOW_LOGS = false;
+static _Thread_local FILE *parser_output = NULL;
+// [error] of the result being read, NULL between reads
+static _Thread_local char *parser_error_text = NULL;
+static _Thread_local JsonTokenizer *tokenizer = NULL;
+static _Thread_local ScenarioFields scenario_fields;
+static _Thread_local int vehicle_groups_capacity = 0;
+static _Thread_local _Bool is_vehicle_allocation_failed = false;
+static _Thread_local _Bool is_vehicle_count_overflow = false;
+static ScenarioLimits scenario_limits = {
+    DEFAULT_MAX_VEHICLES,
+    DEFAULT_MAX_FUEL_PUMPS_COUNT,
+    DEFAULT_MAX_INITIAL_FUEL_IN_TANKER,
+    DEFAULT_MAX_FUEL_TRANSFER_RATE,
+};
+
+static FieldDescriptor scenario_field_descriptors[] = {
+    {"fuel_pumps_count", FIELD_INT, offsetof(ScenarioFields, fuel_pumps_count), 0},
+    {"max_vehicle_capacity", FIELD_INT, offsetof(ScenarioFields, max_vehicle_capacity), 0},
+    {"initial_fuel_in_tanker", FIELD_INT, offsetof(ScenarioFields, initial_fuel_in_tanker), 0},
+    {"fuel_transfer_rate", FIELD_INT, offsetof(ScenarioFields, fuel_transfer_rate), 0},
+    {"randomize_arrival", FIELD_BOOL, offsetof(ScenarioFields, randomize_arrival), 0},
+    {"vehicles", FIELD_VEHICLES, 0, 0},
+};
+static FieldDescriptor vehicle_entry_field_descriptors[] = {
+    {"vehicle_type", FIELD_VEHICLE_TYPE, 0, 0},
+    {"default_fuel_needed", FIELD_INT, offsetof(VehicleEntry, default_fuel_needed), 0},
+    {"default_wait_time_sec", FIELD_INT, offsetof(VehicleEntry, default_wait_time_sec), 0},
+    {"default_count", FIELD_INT, offsetof(VehicleEntry, default_count), 0},
+    {"custom_waiting_list", FIELD_CUSTOM_WAITING_LIST, 0, 0},
+};
+static FieldDescriptor custom_item_field_descriptors[] = {
+    {"fuel_needed", FIELD_INT, offsetof(CustomItemFields, fuel_needed), 0},
+    {"wait_time_sec", FIELD_INT, offsetof(CustomItemFields, wait_time_sec), 0},
+    {"count", FIELD_INT, offsetof(CustomItemFields, count), 0},
+};
+
+static FieldTable scenario_field_table = {scenario_field_descriptors, sizeof(scenario_field_descriptors) / sizeof(FieldDescriptor), {0}};
+static FieldTable vehicle_entry_field_table = {vehicle_entry_field_descriptors, sizeof(vehicle_entry_field_descriptors) / sizeof(FieldDescriptor), {0}};
+static FieldTable custom_item_field_table = {custom_item_field_descriptors, sizeof(custom_item_field_descriptors) / sizeof(FieldDescriptor), {0}};
+static pthread_once_t field_tables_once = PTHREAD_ONCE_INIT;
 
 // ============
 
@@ -30,41 +163,33 @@ void clean_up();
 void clean_up_json_result(UserJsonResult **json_result);
 void clean_up_read_data_parser_result(ReadDataParserResult **read_data_parser_result);
 
-VehicleType get_vehicle_type(cJSON *vehicle_p, _Bool show_logs_now, int index);
+VehicleType get_vehicle_type(const VehicleEntry *vehicle_entry, _Bool show_logs_now, int index);
 
-int get_file_size(FILE *fp);
-int get_default_count(cJSON *vehicle_p, int *default_count, _Bool show_logs_now);
-int get_default_fuel_needed(cJSON *vehicle_p, int *default_fuel_needed, _Bool show_logs_now);
-int get_default_wait_time_sec(cJSON *vehicle_p, int *default_wait_time_sec, _Bool show_logs_now);
-int handle_parse_file_buffer(ReadDataParserResult **read_data_parser_result);
-int handle_get_file_buffer(char *path, ReadDataParserResult **read_data_parser_result);
+int get_default_count(const IntField *field, int64_t *default_count, _Bool show_logs_now);
+int get_default_fuel_needed(const IntField *field, int *default_fuel_needed, _Bool show_logs_now);
+int get_default_wait_time_sec(const IntField *field, int *default_wait_time_sec, _Bool show_logs_now);
+int handle_parse_scenario(UserJsonResult **json_result, ReadDataParserResult **read_data_parser_result);
+int handle_open_tokenizer(char *path, ReadDataParserResult **read_data_parser_result);
 int handle_read_data_parser_result_creation(ReadDataParserResult **read_data_parser_result);
 int handle_result_vehicles(UserJsonResult **json_result, ReadDataParserResult **read_data_parser_result);
 int handle_get_all_vehicles(UserJsonResult **json_result, ReadDataParserResult **read_data_parser_result);
-int handle_randomize_vehicles(UserJsonResult **json_result, ReadDataParserResult **read_data_parser_result);
-int handle_get_limited_amount(UserJsonResult **json_result, ReadDataParserResult **read_data_parser_result);
 int handle_json_result_creation(UserJsonResult **json_result, ReadDataParserResult **read_data_parser_result);
 int handle_fuel_pumps_count(int *fuel_pumps_count, UserJsonResult **json_result, ReadDataParserResult **read_data_parser_result);
-int handle_fuel_transfer_rate(int *fuel_transfer_rate, UserJsonResult **json_result, ReadDataParserResult **read_data_parser_result);
+int handle_fuel_transfer_rate(int64_t *fuel_transfer_rate, UserJsonResult **json_result, ReadDataParserResult **read_data_parser_result);
 int handle_randomize_arrival(_Bool *randomize_arrival, UserJsonResult **json_result, ReadDataParserResult **read_data_parser_result);
-int handle_max_vehicle_capacity(int *max_vehicle_capacity, UserJsonResult **json_result, ReadDataParserResult **read_data_parser_result);
-int handle_initial_fuel_in_tanker(int *initial_fuel_in_tanker, UserJsonResult **json_result, ReadDataParserResult **read_data_parser_result);
-
-StatusType get_file_buffer(char **buffer, char *path);
-StatusType parse_file_buffer(cJSON **json, char **buffer);
-StatusType randomize_vehicles(UserJsonResult *json_result);
-StatusType get_limited_amount(UserJsonResult *json_result);
-StatusType get_int_value(cJSON *json, int *result, char *name);
-StatusType get_array_value(cJSON *json, void **result, char *name);
-StatusType get_string_value(cJSON *json, char **result, char *name);
-StatusType get_boolean_value(cJSON *json, _Bool *result, char *name);
-StatusType get_all_vehicles(cJSON *json, UserJsonResult *json_result);
-StatusType validate_custom_waiting_list(cJSON *json, int *local_vehicle_capacity, _Bool show_logs_now);
-StatusType get_custom_waiting_list_count(cJSON *custom_waiting_list_item_p, int *count, _Bool show_logs_now);
-StatusType validate_vehicles(cJSON *vehicles_array_p, int *all_vehicles_length, int *valid_indexes);
-StatusType get_custom_waiting_list_fuel_needed(cJSON *custom_waiting_list_item_p, int *fuel_needed, _Bool show_logs_now);
-StatusType get_custom_waiting_list_wait_time_sec(cJSON *custom_waiting_list_item_p, int *wait_time_sec, _Bool show_logs_now);
-StatusType get_custom_waiting_list(cJSON *json, VehicleType vehicle_type, int default_wait_time_sec, int default_fuel_needed, Vehicle **all_user_vehicles, int *count_added_vehicles, _Bool show_logs_now);
+int handle_max_vehicle_capacity(int64_t *max_vehicle_capacity, UserJsonResult **json_result, ReadDataParserResult **read_data_parser_result);
+int handle_initial_fuel_in_tanker(int64_t *initial_fuel_in_tanker, UserJsonResult **json_result, ReadDataParserResult **read_data_parser_result);
+
+StatusType parse_scenario(UserJsonResult *json_result);
+StatusType parse_vehicles(UserJsonResult *json_result);
+StatusType parse_vehicle_entry(UserJsonResult *json_result, int index, _Bool *is_valid);
+StatusType parse_custom_waiting_list(UserJsonResult *json_result, VehicleEntry *vehicle_entry, int index);
+StatusType get_int_value(const IntField *field, int *result);
+StatusType get_int64_value(const IntField *field, int64_t *result);
+StatusType get_boolean_value(const BoolField *field, _Bool *result);
+StatusType get_custom_waiting_list_count(const IntField *field, int64_t *count, _Bool show_logs_now);
+StatusType get_custom_waiting_list_fuel_needed(const IntField *field, int *fuel_needed, _Bool show_logs_now);
+StatusType get_custom_waiting_list_wait_time_sec(const IntField *field, int *wait_time_sec, _Bool show_logs_now);
 
 // ============
 
@@ -72,12 +197,118 @@ StatusType get_custom_waiting_list(cJSON *json, VehicleType vehicle_type, int de
 
 // ============
 
+static void parser_printf(const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    vfprintf(parser_output != NULL ? parser_output : stdout, format, args);
+    va_end(args);
+}
+
+// Prints like parser_printf and keeps the first error of the current read in the result, without the "❌ " mark
+static void parser_error(const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    vfprintf(parser_output != NULL ? parser_output : stdout, format, args);
+    va_end(args);
+    if (parser_error_text == NULL || parser_error_text[0] != '\0')
+    {
+        return;
+    }
+
+    char line[2 * READ_DATA_PARSER_ERROR_LENGTH];
+    va_start(args, format);
+    vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    const char *text = strncmp(line, PARSER_ERROR_MARK, strlen(PARSER_ERROR_MARK)) == 0 ? line + strlen(PARSER_ERROR_MARK) : line;
+    size_t length = strcspn(text, "\n");
+    if (length > READ_DATA_PARSER_ERROR_LENGTH - 1)
+    {
+        length = READ_DATA_PARSER_ERROR_LENGTH - 1;
+        // Do not cut a multi-byte character in half
+        while (length > 0 && ((unsigned char)text[length] & 0xC0) == 0x80)
+        {
+            length--;
+        }
+    }
+    memcpy(parser_error_text, text, length);
+    parser_error_text[length] = '\0';
+}
+
+void set_read_data_parser_output(FILE *output)
+{
+    parser_output = output;
+}
+
+void set_scenario_limits(const ScenarioLimits *limits)
+{
+    scenario_limits = *limits;
+}
+
+const ScenarioLimits *get_scenario_limits()
+{
+    return &scenario_limits;
+}
+
+int parse_scenario_limit_argument(int argc, char **argv, int *index)
+{
+    ScenarioLimits limits = scenario_limits;
+    int64_t *limit = NULL;
+    const char *option = argv[*index];
+    if (strcmp(option, "--max-vehicles") == 0)
+    {
+        limit = &limits.max_vehicles;
+    }
+    else if (strcmp(option, "--max-fuel-pumps") == 0)
+    {
+        limit = &limits.max_fuel_pumps_count;
+    }
+    else if (strcmp(option, "--max-tanker-fuel") == 0)
+    {
+        limit = &limits.max_initial_fuel_in_tanker;
+    }
+    else if (strcmp(option, "--max-transfer-rate") == 0)
+    {
+        limit = &limits.max_fuel_transfer_rate;
+    }
+    else
+    {
+        return 0;
+    }
+
+    if ((*index) + 1 >= argc)
+    {
+        parser_error("❌ [%s]: Missing limit.\n", option);
+        return -1;
+    }
+    const char *value = argv[++(*index)];
+    char *end = NULL;
+    errno = 0;
+    long long parsed = strtoll(value, &end, 10);
+    if (end == value || *end != '\0' || errno == ERANGE || parsed <= 0)
+    {
+        parser_error("❌ [%s]: Invalid limit '%s'. Expected a positive number.\n", option, value);
+        return -1;
+    }
+    // [fuel_pumps_count] stays an int
+    if (limit == &limits.max_fuel_pumps_count && parsed > INT_MAX)
+    {
+        parser_error("❌ [%s]: Invalid limit '%s'. Must be at most %d.\n", option, value, INT_MAX);
+        return -1;
+    }
+    *limit = (int64_t)parsed;
+    set_scenario_limits(&limits);
+    return 1;
+}
+
 ReadDataParserResult *read_data_parser(char *path, _Bool show_logs)
 {
     SHOW_LOGS = show_logs;
+    parser_error_text = NULL;
     if (path == NULL)
     {
-        printf("❌ Path string to 'data.json' file is empty\n");
+        parser_error("❌ Path string to 'data.json' file is empty\n");
         return NULL;
     }
 
@@ -87,18 +318,19 @@ ReadDataParserResult *read_data_parser(char *path, _Bool show_logs)
         return NULL;
     }
 
-    if (handle_get_file_buffer(path, &read_data_parser_result) == 0)
+    if (handle_open_tokenizer(path, &read_data_parser_result) == 0)
     {
         return read_data_parser_result;
     }
 
-    if (handle_parse_file_buffer(&read_data_parser_result) == 0)
+    UserJsonResult *json_result = NULL;
+    if (handle_json_result_creation(&json_result, &read_data_parser_result) == 0)
     {
         return read_data_parser_result;
     }
 
-    UserJsonResult *json_result = NULL;
-    if (handle_json_result_creation(&json_result, &read_data_parser_result) == 0)
+    // The whole file is read in one pass, the checks below then run in their usual order
+    if (handle_parse_scenario(&json_result, &read_data_parser_result) == 0)
     {
         return read_data_parser_result;
     }
@@ -115,19 +347,19 @@ ReadDataParserResult *read_data_parser(char *path, _Bool show_logs)
         return read_data_parser_result;
     }
 
-    int max_vehicle_capacity = 0;
+    int64_t max_vehicle_capacity = 0;
     if (handle_max_vehicle_capacity(&max_vehicle_capacity, &json_result, &read_data_parser_result) == 0)
     {
         return read_data_parser_result;
     }
 
-    int initial_fuel_in_tanker = 0;
+    int64_t initial_fuel_in_tanker = 0;
     if (handle_initial_fuel_in_tanker(&initial_fuel_in_tanker, &json_result, &read_data_parser_result) == 0)
     {
         return read_data_parser_result;
     }
 
-    int fuel_transfer_rate = 0;
+    int64_t fuel_transfer_rate = 0;
     if (handle_fuel_transfer_rate(&fuel_transfer_rate, &json_result, &read_data_parser_result) == 0)
     {
         return read_data_parser_result;
@@ -153,161 +385,204 @@ ReadDataParserResult *read_data_parser(char *path, _Bool show_logs)
 
 // ============
 
-int get_file_size(FILE *fp)
+// Skips the rest of a value whose first token was already read; 0 on a syntax error
+static int skip_started_value(JsonTokenType type)
 {
-    int size = 0;
-    if (fseek(fp, 0, SEEK_END) != 0)
+    if (type == JSON_TOKEN_ERROR)
     {
-        printf("❌ Failed to seek to end of file\n");
-        return -1;
+        return 0;
     }
-    size = ftell(fp);
-    if (fseek(fp, 0, SEEK_SET) != 0)
+    if (type != JSON_TOKEN_BEGIN_OBJECT && type != JSON_TOKEN_BEGIN_ARRAY)
     {
-        printf("❌ Failed to seek to beginning of file\n");
-        return -1;
+        return 1;
     }
-
-    return size;
+    int depth = 1;
+    while (depth > 0)
+    {
+        type = json_tokenizer_next(tokenizer);
+        if (type == JSON_TOKEN_ERROR || type == JSON_TOKEN_END)
+        {
+            return 0;
+        }
+        if (type == JSON_TOKEN_BEGIN_OBJECT || type == JSON_TOKEN_BEGIN_ARRAY)
+        {
+            depth++;
+        }
+        if (type == JSON_TOKEN_END_OBJECT || type == JSON_TOKEN_END_ARRAY)
+        {
+            depth--;
+        }
+    }
+    return 1;
 }
 
-StatusType get_file_buffer(char **buffer, char *path)
+// Numbers outside int64 are rejected as MAX_VALUE_ERROR, the others truncated like cJSON's valueint.
+// (double)INT64_MAX rounds up to 2^63, which no longer fits
+static int is_int64_number(double number)
 {
-    FILE *fp = fopen(path, "r");
-    if (fp == NULL)
-    {
-        perror("❌ Unable to open the file.\n");
-        return UNKNOWN_ERROR;
-    }
+    return number < (double)INT64_MAX && number >= (double)INT64_MIN;
+}
 
-    const int size = get_file_size(fp);
-    if (size < 0)
-    {
-        printf("❌ Unable to get file size.\n");
-        fclose(fp);
-        return UNKNOWN_ERROR;
-    }
+static void init_int_field(IntField *field)
+{
+    field->status = NOT_FOUND;
+    field->value = 0;
+}
 
-    (*buffer) = (char *)malloc((size + 1) * sizeof(char));
-    if ((*buffer) == NULL)
-    {
-        printf("❌ Unable to allocate memory for file buffer.\n");
-        fclose(fp);
-        return ALLOCATION_ERROR;
-    }
-    size_t number_of_bytes_transferred = fread((*buffer), 1, size, fp);
-    if (number_of_bytes_transferred != (size_t)size)
+static int read_int_field(IntField *field)
+{
+    JsonTokenType type = json_tokenizer_next(tokenizer);
+    if (field->status == NOT_FOUND)
     {
-        printf("❌ Expected to read %d bytes, but read only %ld bytes.\n", size, number_of_bytes_transferred);
-        fclose(fp);
-        return UNKNOWN_ERROR;
+        if (type == JSON_TOKEN_NUMBER)
+        {
+            field->status = is_int64_number(tokenizer->number) ? CORRECT_VALUE : MAX_VALUE_ERROR;
+            field->value = field->status == CORRECT_VALUE ? (int64_t)tokenizer->number : 0;
+            return 1;
+        }
+        field->status = WRONG_TYPE;
     }
-
-    // malloc will allocate size + 1 for '\n', and we need to add this '\0' at the end
-    (*buffer)[size] = '\0';
-    fclose(fp);
-
-    return CORRECT_VALUE;
+    return skip_started_value(type);
 }
 
-StatusType parse_file_buffer(cJSON **json, char **buffer)
+static int read_boolean_field(BoolField *field)
 {
-    (*json) = cJSON_Parse((*buffer));
-    if (*json == NULL)
+    JsonTokenType type = json_tokenizer_next(tokenizer);
+    if (field->status == NOT_FOUND)
     {
-        const char *error_ptr = cJSON_GetErrorPtr();
-        if (error_ptr != NULL)
+        if (type == JSON_TOKEN_TRUE || type == JSON_TOKEN_FALSE)
         {
-            printf("❌ Error on parse JSON: %s\n", error_ptr);
+            field->status = CORRECT_VALUE;
+            field->value = type == JSON_TOKEN_TRUE;
+            return 1;
         }
-        return UNKNOWN_ERROR;
+        field->status = WRONG_TYPE;
     }
-    return CORRECT_VALUE;
+    return skip_started_value(type);
 }
 
-// ============
-
-//
-
-// ============
-
-StatusType get_int_value(cJSON *json, int *result, char *name)
+static int read_vehicle_type_field(VehicleEntry *vehicle_entry)
 {
-    cJSON *int_value_p = cJSON_GetObjectItemCaseSensitive(json, name);
-    if (int_value_p == NULL)
+    JsonTokenType type = json_tokenizer_next(tokenizer);
+    if (vehicle_entry->vehicle_type_status != NOT_FOUND)
     {
-        return NOT_FOUND;
+        return skip_started_value(type);
     }
-    if (!cJSON_IsNumber(int_value_p))
+    if (type != JSON_TOKEN_STRING)
     {
-        return WRONG_TYPE;
+        vehicle_entry->vehicle_type_status = WRONG_TYPE;
+        return skip_started_value(type);
     }
 
-    *result = int_value_p->valueint;
-    return CORRECT_VALUE;
-}
-
-StatusType get_string_value(cJSON *json, char **result, char *name)
-{
-    cJSON *string_value_p = cJSON_GetObjectItemCaseSensitive(json, name);
-    if (string_value_p == NULL)
+    vehicle_entry->vehicle_type_status = CORRECT_VALUE;
+    if (strcmp(tokenizer->text, "auto") == 0)
     {
-        return NOT_FOUND;
+        vehicle_entry->vehicle_type = VEHICLE_AUTO;
     }
-    if (!cJSON_IsString(string_value_p))
+    else if (strcmp(tokenizer->text, "truck") == 0)
     {
-        return WRONG_TYPE;
+        vehicle_entry->vehicle_type = VEHICLE_TRUCK;
     }
-    size_t string_length = strlen(string_value_p->valuestring);
-
-    // malloc will allocate only string_length, but we need to add '\0' at the end
-    *(result) = (char *)malloc((string_length + 1) * sizeof(char));
-    if (*(result) == NULL)
+    else if (strcmp(tokenizer->text, "van") == 0)
     {
-        return ALLOCATION_ERROR;
+        vehicle_entry->vehicle_type = VEHICLE_VAN;
     }
-    strcpy((*result), string_value_p->valuestring);
-
-    return CORRECT_VALUE;
+    else
+    {
+        vehicle_entry->vehicle_type_status = tokenizer->text_length == 0 ? EMPTY_VALUE : WRONG_VALUE;
+    }
+    return 1;
 }
 
-StatusType get_boolean_value(cJSON *json, _Bool *result, char *name)
+static void build_field_table(FieldTable *table)
 {
-    cJSON *boolean_value_p = cJSON_GetObjectItemCaseSensitive(json, name);
-    if (boolean_value_p == NULL)
+    for (int i = 0; i < table->fields_count; i++)
     {
-        return NOT_FOUND;
+        FieldDescriptor *field = &table->fields[i];
+        field->key_hash = json_key_hash(field->key, strlen(field->key));
+        int slot = field->key_hash & (FIELD_TABLE_SLOTS - 1);
+        while (table->slots[slot] != 0)
+        {
+            slot = (slot + 1) & (FIELD_TABLE_SLOTS - 1);
+        }
+        table->slots[slot] = (unsigned char)(i + 1);
     }
-    if (!cJSON_IsBool(boolean_value_p))
+}
+
+static void build_field_tables()
+{
+    build_field_table(&scenario_field_table);
+    build_field_table(&vehicle_entry_field_table);
+    build_field_table(&custom_item_field_table);
+}
+
+// Descriptor of the current key, NULL for keys the scenario does not use
+static const FieldDescriptor *find_field(const FieldTable *table)
+{
+    int slot = tokenizer->key_hash & (FIELD_TABLE_SLOTS - 1);
+    while (table->slots[slot] != 0)
     {
-        return WRONG_TYPE;
+        const FieldDescriptor *field = &table->fields[table->slots[slot] - 1];
+        if (field->key_hash == tokenizer->key_hash && strcmp(field->key, tokenizer->text) == 0)
+        {
+            return field;
+        }
+        slot = (slot + 1) & (FIELD_TABLE_SLOTS - 1);
     }
+    return NULL;
+}
 
-    if (cJSON_IsFalse(boolean_value_p))
+// Reads the value of a scalar field into [fields]; unknown keys and nested kinds are skipped
+static int read_field(const FieldDescriptor *field, void *fields)
+{
+    if (field == NULL)
     {
-        *result = 0;
+        return json_tokenizer_skip_value(tokenizer);
     }
-    if (cJSON_IsTrue(boolean_value_p))
+    switch (field->kind)
     {
-        *result = 1;
+    case FIELD_INT:
+        return read_int_field((IntField *)((char *)fields + field->offset));
+    case FIELD_BOOL:
+        return read_boolean_field((BoolField *)((char *)fields + field->offset));
+    case FIELD_VEHICLE_TYPE:
+        return read_vehicle_type_field((VehicleEntry *)fields);
+    default:
+        return json_tokenizer_skip_value(tokenizer);
     }
-    return CORRECT_VALUE;
 }
 
-StatusType get_array_value(cJSON *json, void **result, char *name)
+// Per-vehicle values stay int; a value outside int is MAX_VALUE_ERROR rather than clamped,
+// which would let it land exactly on a limit
+StatusType get_int_value(const IntField *field, int *result)
 {
-    cJSON *array_value_p = cJSON_GetObjectItemCaseSensitive(json, name);
-    if (array_value_p == NULL)
+    if (field->status == CORRECT_VALUE)
     {
-        return NOT_FOUND;
+        if (field->value > INT_MAX || field->value < INT_MIN)
+        {
+            return MAX_VALUE_ERROR;
+        }
+        *result = (int)field->value;
     }
-    if (!cJSON_IsArray(array_value_p))
+    return field->status;
+}
+
+StatusType get_int64_value(const IntField *field, int64_t *result)
+{
+    if (field->status == CORRECT_VALUE)
     {
-        return WRONG_TYPE;
+        *result = field->value;
     }
+    return field->status;
+}
 
-    *result = array_value_p;
-    return CORRECT_VALUE;
+StatusType get_boolean_value(const BoolField *field, _Bool *result)
+{
+    if (field->status == CORRECT_VALUE)
+    {
+        *result = field->value;
+    }
+    return field->status;
 }
 
 // ============
@@ -316,85 +591,48 @@ StatusType get_array_value(cJSON *json, void **result, char *name)
 
 // ============
 
-VehicleType get_vehicle_type(cJSON *vehicle_p, _Bool show_logs_now, int index)
+VehicleType get_vehicle_type(const VehicleEntry *vehicle_entry, _Bool show_logs_now, int index)
 {
     VehicleType result_vehicle_type = VEHICLE_NOT_FOUND;
 
-    char *vehicle_type = NULL;
-    StatusType vehicle_type_result = get_string_value(vehicle_p, &vehicle_type, "vehicle_type");
-    if (vehicle_type_result == ALLOCATION_ERROR)
-    {
-        if (SHOW_LOGS && show_logs_now)
-        {
-            printf("📌 Vehicle #%d ❌ (Allocation error)\n", index);
-        }
-    }
+    StatusType vehicle_type_result = vehicle_entry->vehicle_type_status;
     if (vehicle_type_result == NOT_FOUND)
     {
         if (SHOW_LOGS && show_logs_now)
         {
-            printf("📌 Vehicle #%d ❌ (Field is required)\n", index);
+            parser_printf("📌 Vehicle #%d ❌ (Field is required)\n", index);
         }
     }
-    if (vehicle_type_result == WRONG_TYPE)
+    else if (vehicle_type_result == WRONG_TYPE)
     {
         if (SHOW_LOGS && show_logs_now)
         {
-            printf("📌 Vehicle #%d ❌ (Is not string)\n", index);
+            parser_printf("📌 Vehicle #%d ❌ (Is not string)\n", index);
         }
     }
-
-    if (vehicle_type == NULL)
-    {
-        // skip, allocation error
-    }
-    else if (strcmp(vehicle_type, "auto") == 0)
+    else if (vehicle_type_result == EMPTY_VALUE)
     {
         if (SHOW_LOGS && show_logs_now)
         {
-            printf("📌 Vehicle #%d (%s)\n", index, AUTO_ICON);
-            // printf("✅ [vehicle_type]: 🚗\n");
+            parser_printf("📌 Vehicle #%d ❌ (Empty name)\n", index);
         }
-        result_vehicle_type = VEHICLE_AUTO;
     }
-    else if (strcmp(vehicle_type, "truck") == 0)
+    else if (vehicle_type_result == WRONG_VALUE)
     {
         if (SHOW_LOGS && show_logs_now)
         {
-            printf("📌 Vehicle #%d (%s)\n", index, TRUCK_ICON);
-            // printf("✅ [vehicle_type]: 🚛\n");
+            parser_printf("📌 Vehicle #%d ❌ (Wrong type name)\n", index);
         }
-        result_vehicle_type = VEHICLE_TRUCK;
-    }
-    else if (strcmp(vehicle_type, "van") == 0)
-    {
-        if (SHOW_LOGS && show_logs_now)
-        {
-            printf("📌 Vehicle #%d (%s)\n", index, VAN_ICON);
-            // printf("✅ [vehicle_type]: 🚙\n");
-        }
-        result_vehicle_type = VEHICLE_VAN;
     }
     else
     {
-        if (strlen(vehicle_type) == 0)
-        {
-            if (SHOW_LOGS && show_logs_now)
-            {
-                printf("📌 Vehicle #%d ❌ (Empty name)\n", index);
-            }
-        }
-        else
+        if (SHOW_LOGS && show_logs_now)
         {
-            if (SHOW_LOGS && show_logs_now)
-            {
-                printf("📌 Vehicle #%d ❌ (Wrong type name)\n", index);
-            }
+            parser_printf("📌 Vehicle #%d (%s)\n", index, get_vehicle_icon(vehicle_entry->vehicle_type));
         }
-        result_vehicle_type = VEHICLE_NOT_FOUND;
+        result_vehicle_type = vehicle_entry->vehicle_type;
     }
 
-    free(vehicle_type);
     return result_vehicle_type;
 }
 
@@ -408,24 +646,14 @@ void clean_up()
 {
     if (SHOW_LOGS)
     {
-        printf("\n🧹 Cleaning up parser script...\n");
+        parser_printf("\n🧹 Cleaning up parser script...\n");
     }
-    if (buffer != NULL)
+    if (tokenizer != NULL)
     {
-        free(buffer);
-        buffer = NULL;
+        json_tokenizer_close(&tokenizer);
         if (SHOW_LOGS)
         {
-            printf("   ├─ ✅ Buffer cleaned up\n");
-        }
-    }
-    if (json != NULL)
-    {
-        cJSON_Delete(json);
-        json = NULL;
-        if (SHOW_LOGS)
-        {
-            printf("   └─ ✅ JSON cleaned up!\n");
+            parser_printf("   └─ ✅ Tokenizer cleaned up!\n");
         }
     }
 }
@@ -436,35 +664,13 @@ void clean_up_json_result(UserJsonResult **json_result)
     {
         return;
     }
-    if ((*json_result)->all_vehicles != NULL)
-    {
-        for (int i = 0; i < (*json_result)->all_vehicles_length; i++)
-        {
-            if ((*json_result)->all_vehicles[i] != NULL)
-            {
-                free((*json_result)->all_vehicles[i]);
-                (*json_result)->all_vehicles[i] = NULL;
-            }
-        }
-
-        // If we allocated new array for result_vehicles
-        if ((*json_result)->result_vehicles != (*json_result)->all_vehicles)
-        {
-            if ((*json_result)->result_vehicles != NULL)
-            {
-                free((*json_result)->result_vehicles);
-                (*json_result)->result_vehicles = NULL;
-            }
-        }
-
-        free((*json_result)->all_vehicles);
-        (*json_result)->all_vehicles = NULL;
-    }
+    free((*json_result)->vehicle_groups);
+    (*json_result)->vehicle_groups = NULL;
     free((*json_result));
     (*json_result) = NULL;
     if (SHOW_LOGS)
     {
-        printf("   ├─ ✅ Cleaning data results finished!\n");
+        parser_printf("   ├─ ✅ Cleaning data results finished!\n");
     }
 }
 
@@ -478,175 +684,16 @@ void clean_up_read_data_parser_result(ReadDataParserResult **read_data_parser_re
     clean_up_json_result(
         &((*read_data_parser_result)->json_result) //
     );
-    free((*read_data_parser_result));
-    *read_data_parser_result = NULL;
-    if (SHOW_LOGS)
-    {
-        printf("   ├─ ✅ Cleaning user results finished!\n");
-    }
-}
-
-// ============
-
-//
-
-// ============
-
-StatusType randomize_vehicles(UserJsonResult *json_result)
-{
-    if (SHOW_LOGS)
-    {
-        printf("✅ Program is running randomizer...\n");
-    }
-    srand(time(NULL));
-    json_result->result_vehicles = (Vehicle **)malloc(json_result->result_vehicles_length * sizeof(Vehicle));
-    if (json_result->result_vehicles == NULL)
-    {
-        return ALLOCATION_ERROR;
-    }
-
-    // O(n*n) ❌ Custom solution
-    // const int length = 10;
-    // int array[length];
-    // for (int i = 0; i < length; array[i] = -1, i++)
-    //     ;
-    // for (int i = 0; i < length; i++)
-    // {
-    //     _Bool flag = 0;
-    //     while (flag == 0)
-    //     {
-    //         int rand_value = rand() % length;
-    //         _Bool match = 0;
-    //         for (int j = 0; j < length; j++)
-    //         {
-    //             if (array[j] == rand_value)
-    //             {
-    //                 match = 1;
-    //                 break;
-    //             }
-    //         }
-    //         if (match == 0)
-    //         {
-    //             array[i] = rand_value;
-    //             flag = 1;
-    //         }
-    //         if (match == 1)
-    //         {
-    //             int new_rand_value = rand() % length;
-    //             if (new_rand_value == rand_value)
-    //             {
-    //                 continue;
-    //             }
-    //         }
-    //     }
-    // }
-
-    // O(n) ✅ Fisher-Yates Shuffle
-    // const int length = 10;
-    // int array[length];
-    // for (int i = 0; i < length; array[i] = i, i++)
-    //     ;
-    // for (int i = length - 1; i >= 0; i--)
-    // {
-    //     int j = rand() % (i + 1);
-    //     int temp = array[i];
-    //     array[i] = array[j];
-    //     array[j] = temp;
-    // }
-
-    const int bigger_length = json_result->all_vehicles_length;
-    const int result_length = json_result->result_vehicles_length;
-
-    if (bigger_length < result_length)
-    {
-        printf("❌ Max vehicle array length is less current.\n");
-        return WRONG_VALUE;
-    }
-
-    _Bool is_equal = bigger_length == result_length;
-
-    int bigger_array[bigger_length];
-    int result_array[result_length];
-
-    for (int i = 0; i < bigger_length; bigger_array[i] = i, i++)
-        ;
-
-    for (int i = bigger_length - 1; i >= 0; i--)
-    {
-        int j = rand() % (i + 1);
-        int temp = bigger_array[i];
-        bigger_array[i] = bigger_array[j];
-        bigger_array[j] = temp;
-    }
-
-    if (!is_equal)
+    if (parser_error_text == (*read_data_parser_result)->error)
     {
-        for (int i = 0; i < result_length; i++)
-        {
-            result_array[i] = bigger_array[i];
-        }
+        parser_error_text = NULL;
     }
-
-    for (int j = 0; j < result_length; j++)
-    {
-        int index = !is_equal ? result_array[j] : bigger_array[j];
-        json_result->result_vehicles[j] = json_result->all_vehicles[index];
-    }
-    return CORRECT_VALUE;
-}
-
-int handle_randomize_vehicles(UserJsonResult **json_result, ReadDataParserResult **read_data_parser_result)
-{
-    StatusType randomize_result = randomize_vehicles((*json_result));
-    if (randomize_result == ALLOCATION_ERROR)
-    {
-        printf("❌ [result_vehicles] unable to allocate memory.\n");
-        clean_up();
-        clean_up_json_result(json_result);
-        (*read_data_parser_result)->status = ALLOCATION_ERROR;
-        return 0;
-    }
-    if (randomize_result == WRONG_VALUE)
-    {
-        clean_up();
-        clean_up_json_result(json_result);
-        (*read_data_parser_result)->status = WRONG_VALUE;
-        return 0;
-    }
-    return 1;
-}
-
-StatusType get_limited_amount(UserJsonResult *json_result)
-{
+    free((*read_data_parser_result));
+    *read_data_parser_result = NULL;
     if (SHOW_LOGS)
     {
-        printf("✅ Program is selecting first %d vehicles...\n", json_result->result_vehicles_length);
-    }
-    json_result->result_vehicles = (Vehicle **)malloc(json_result->result_vehicles_length * sizeof(Vehicle));
-    if (json_result->result_vehicles == NULL)
-    {
-        return ALLOCATION_ERROR;
-    }
-
-    for (int j = 0; j < json_result->result_vehicles_length; j++)
-    {
-        json_result->result_vehicles[j] = json_result->all_vehicles[j];
-    }
-    return CORRECT_VALUE;
-}
-
-int handle_get_limited_amount(UserJsonResult **json_result, ReadDataParserResult **read_data_parser_result)
-{
-    StatusType limited_amount_result = get_limited_amount((*json_result));
-    if (limited_amount_result == ALLOCATION_ERROR)
-    {
-        printf("❌ [result_vehicles] unable to allocate memory.\n");
-        clean_up();
-        clean_up_json_result(json_result);
-        (*read_data_parser_result)->status = ALLOCATION_ERROR;
-        return 0;
+        parser_printf("   ├─ ✅ Cleaning user results finished!\n");
     }
-    return 1;
 }
 
 // ============
@@ -660,13 +707,16 @@ int handle_json_result_creation(UserJsonResult **json_result, ReadDataParserResu
     (*json_result) = (UserJsonResult *)malloc(sizeof(UserJsonResult));
     if ((*json_result) == NULL)
     {
-        printf("❌ Unable to allocate memory for [json_result].\n");
+        parser_error("❌ Unable to allocate memory for [json_result].\n");
         clean_up();
         (*read_data_parser_result)->status = ALLOCATION_ERROR;
         return 0;
     }
-    (*json_result)->all_vehicles = NULL;
-    (*json_result)->result_vehicles = NULL;
+    (*json_result)->vehicle_groups = NULL;
+    (*json_result)->vehicle_groups_length = 0;
+    (*json_result)->all_vehicles_length = 0;
+    (*json_result)->result_vehicles_length = 0;
+    (*json_result)->random_seed = 0;
     return 1;
 }
 
@@ -675,11 +725,13 @@ int handle_read_data_parser_result_creation(ReadDataParserResult **read_data_par
     (*read_data_parser_result) = (ReadDataParserResult *)malloc(sizeof(ReadDataParserResult));
     if ((*read_data_parser_result) == NULL)
     {
-        printf("❌ Unable to allocate memory for [read_data_parser_result].\n");
+        parser_error("❌ Unable to allocate memory for [read_data_parser_result].\n");
         return 0;
     }
     (*read_data_parser_result)->status = UNKNOWN_ERROR;
     (*read_data_parser_result)->json_result = NULL;
+    (*read_data_parser_result)->error[0] = '\0';
+    parser_error_text = (*read_data_parser_result)->error;
     return 1;
 }
 
@@ -691,10 +743,10 @@ int handle_read_data_parser_result_creation(ReadDataParserResult **read_data_par
 
 int handle_fuel_pumps_count(int *fuel_pumps_count, UserJsonResult **json_result, ReadDataParserResult **read_data_parser_result)
 {
-    StatusType fuel_pumps_count_result = get_int_value(json, fuel_pumps_count, "fuel_pumps_count");
+    StatusType fuel_pumps_count_result = get_int_value(&scenario_fields.fuel_pumps_count, fuel_pumps_count);
     if (fuel_pumps_count_result == NOT_FOUND)
     {
-        printf("❌ [fuel_pumps_count]: Field is required!\n");
+        parser_error("❌ [fuel_pumps_count]: Field is required!\n");
         clean_up();
         clean_up_json_result(json_result);
         (*read_data_parser_result)->status = NOT_FOUND;
@@ -702,15 +754,23 @@ int handle_fuel_pumps_count(int *fuel_pumps_count, UserJsonResult **json_result,
     }
     else if (fuel_pumps_count_result == WRONG_TYPE)
     {
-        printf("❌ [fuel_pumps_count]: Invalid value! Expected a number.\n");
+        parser_error("❌ [fuel_pumps_count]: Invalid value! Expected a number.\n");
         clean_up();
         clean_up_json_result(json_result);
         (*read_data_parser_result)->status = WRONG_TYPE;
         return 0;
     }
-    else if ((*fuel_pumps_count) > MAX_FUEL_PUMPS_COUNT)
+    else if (fuel_pumps_count_result == MAX_VALUE_ERROR)
     {
-        printf("❌ [fuel_pumps_count]: Must be less than or equal to the maximum limit of %d.\n", MAX_FUEL_PUMPS_COUNT);
+        parser_error("❌ [fuel_pumps_count]: Value is out of range.\n");
+        clean_up();
+        clean_up_json_result(json_result);
+        (*read_data_parser_result)->status = MAX_VALUE_ERROR;
+        return 0;
+    }
+    else if ((*fuel_pumps_count) > scenario_limits.max_fuel_pumps_count)
+    {
+        parser_error("❌ [fuel_pumps_count]: Must be less than or equal to the maximum limit of %" PRId64 ".\n", scenario_limits.max_fuel_pumps_count);
         clean_up();
         clean_up_json_result(json_result);
         (*read_data_parser_result)->status = MAX_VALUE_ERROR;
@@ -718,7 +778,7 @@ int handle_fuel_pumps_count(int *fuel_pumps_count, UserJsonResult **json_result,
     }
     else if ((*fuel_pumps_count) <= 0)
     {
-        printf("❌ [fuel_pumps_count]: Must be greater than 0.\n");
+        parser_error("❌ [fuel_pumps_count]: Must be greater than 0.\n");
         clean_up();
         clean_up_json_result(json_result);
         (*read_data_parser_result)->status = WRONG_VALUE;
@@ -730,17 +790,17 @@ int handle_fuel_pumps_count(int *fuel_pumps_count, UserJsonResult **json_result,
 
 int handle_randomize_arrival(_Bool *randomize_arrival, UserJsonResult **json_result, ReadDataParserResult **read_data_parser_result)
 {
-    StatusType randomize_arrival_result = get_boolean_value(json, randomize_arrival, "randomize_arrival");
+    StatusType randomize_arrival_result = get_boolean_value(&scenario_fields.randomize_arrival, randomize_arrival);
     if (randomize_arrival_result == NOT_FOUND)
     {
         if (SHOW_LOGS)
         {
-            printf("🔍 [randomize_arrival]: Not found. Defaulting to false.\n");
+            parser_printf("🔍 [randomize_arrival]: Not found. Defaulting to false.\n");
         }
     }
     else if (randomize_arrival_result == WRONG_TYPE)
     {
-        printf("❌ [randomize_arrival]: Invalid value! Expected a boolean.\n");
+        parser_error("❌ [randomize_arrival]: Invalid value! Expected a boolean.\n");
         clean_up();
         clean_up_json_result(json_result);
         (*read_data_parser_result)->status = WRONG_TYPE;
@@ -750,12 +810,12 @@ int handle_randomize_arrival(_Bool *randomize_arrival, UserJsonResult **json_res
     return 1;
 }
 
-int handle_max_vehicle_capacity(int *max_vehicle_capacity, UserJsonResult **json_result, ReadDataParserResult **read_data_parser_result)
+int handle_max_vehicle_capacity(int64_t *max_vehicle_capacity, UserJsonResult **json_result, ReadDataParserResult **read_data_parser_result)
 {
-    StatusType max_vehicle_capacity_result = get_int_value(json, max_vehicle_capacity, "max_vehicle_capacity");
+    StatusType max_vehicle_capacity_result = get_int64_value(&scenario_fields.max_vehicle_capacity, max_vehicle_capacity);
     if (max_vehicle_capacity_result == NOT_FOUND)
     {
-        printf("❌ [max_vehicle_capacity]: Field is required!\n");
+        parser_error("❌ [max_vehicle_capacity]: Field is required!\n");
         clean_up();
         clean_up_json_result(json_result);
         (*read_data_parser_result)->status = NOT_FOUND;
@@ -763,15 +823,23 @@ int handle_max_vehicle_capacity(int *max_vehicle_capacity, UserJsonResult **json
     }
     else if (max_vehicle_capacity_result == WRONG_TYPE)
     {
-        printf("❌ [max_vehicle_capacity]: Invalid value! Expected a number.\n");
+        parser_error("❌ [max_vehicle_capacity]: Invalid value! Expected a number.\n");
         clean_up();
         clean_up_json_result(json_result);
         (*read_data_parser_result)->status = WRONG_TYPE;
         return 0;
     }
-    else if ((*max_vehicle_capacity) > MAX_VEHICLES)
+    else if (max_vehicle_capacity_result == MAX_VALUE_ERROR)
     {
-        printf("❌ [max_vehicle_capacity]: Must be less than or equal to the maximum limit of %d.\n", MAX_VEHICLES);
+        parser_error("❌ [max_vehicle_capacity]: Value is out of range.\n");
+        clean_up();
+        clean_up_json_result(json_result);
+        (*read_data_parser_result)->status = MAX_VALUE_ERROR;
+        return 0;
+    }
+    else if ((*max_vehicle_capacity) > scenario_limits.max_vehicles)
+    {
+        parser_error("❌ [max_vehicle_capacity]: Must be less than or equal to the maximum limit of %" PRId64 ".\n", scenario_limits.max_vehicles);
         clean_up();
         clean_up_json_result(json_result);
         (*read_data_parser_result)->status = MAX_VALUE_ERROR;
@@ -779,7 +847,7 @@ int handle_max_vehicle_capacity(int *max_vehicle_capacity, UserJsonResult **json
     }
     else if ((*max_vehicle_capacity) <= 0)
     {
-        printf("❌ [max_vehicle_capacity]: Must be greater than 0.\n");
+        parser_error("❌ [max_vehicle_capacity]: Must be greater than 0.\n");
         clean_up();
         clean_up_json_result(json_result);
         (*read_data_parser_result)->status = WRONG_VALUE;
@@ -789,12 +857,12 @@ int handle_max_vehicle_capacity(int *max_vehicle_capacity, UserJsonResult **json
     return 1;
 }
 
-int handle_initial_fuel_in_tanker(int *initial_fuel_in_tanker, UserJsonResult **json_result, ReadDataParserResult **read_data_parser_result)
+int handle_initial_fuel_in_tanker(int64_t *initial_fuel_in_tanker, UserJsonResult **json_result, ReadDataParserResult **read_data_parser_result)
 {
-    StatusType initial_fuel_in_tanker_result = get_int_value(json, initial_fuel_in_tanker, "initial_fuel_in_tanker");
+    StatusType initial_fuel_in_tanker_result = get_int64_value(&scenario_fields.initial_fuel_in_tanker, initial_fuel_in_tanker);
     if (initial_fuel_in_tanker_result == NOT_FOUND)
     {
-        printf("❌ [initial_fuel_in_tanker]: Field is required!\n");
+        parser_error("❌ [initial_fuel_in_tanker]: Field is required!\n");
         clean_up();
         clean_up_json_result(json_result);
         (*read_data_parser_result)->status = NOT_FOUND;
@@ -802,15 +870,23 @@ int handle_initial_fuel_in_tanker(int *initial_fuel_in_tanker, UserJsonResult **
     }
     else if (initial_fuel_in_tanker_result == WRONG_TYPE)
     {
-        printf("❌ [initial_fuel_in_tanker]: Invalid value! Expected a number.\n");
+        parser_error("❌ [initial_fuel_in_tanker]: Invalid value! Expected a number.\n");
         clean_up();
         clean_up_json_result(json_result);
         (*read_data_parser_result)->status = WRONG_TYPE;
         return 0;
     }
-    else if ((*initial_fuel_in_tanker) > MAX_INITIAL_FUEL_IN_TANKER)
+    else if (initial_fuel_in_tanker_result == MAX_VALUE_ERROR)
+    {
+        parser_error("❌ [initial_fuel_in_tanker]: Value is out of range.\n");
+        clean_up();
+        clean_up_json_result(json_result);
+        (*read_data_parser_result)->status = MAX_VALUE_ERROR;
+        return 0;
+    }
+    else if ((*initial_fuel_in_tanker) > scenario_limits.max_initial_fuel_in_tanker)
     {
-        printf("❌ [initial_fuel_in_tanker]: Must be less than or equal to the maximum limit of %d.\n", MAX_INITIAL_FUEL_IN_TANKER);
+        parser_error("❌ [initial_fuel_in_tanker]: Must be less than or equal to the maximum limit of %" PRId64 ".\n", scenario_limits.max_initial_fuel_in_tanker);
         clean_up();
         clean_up_json_result(json_result);
         (*read_data_parser_result)->status = MAX_VALUE_ERROR;
@@ -818,7 +894,7 @@ int handle_initial_fuel_in_tanker(int *initial_fuel_in_tanker, UserJsonResult **
     }
     else if ((*initial_fuel_in_tanker) <= 0)
     {
-        printf("❌ [initial_fuel_in_tanker]: Must be greater than 0.\n");
+        parser_error("❌ [initial_fuel_in_tanker]: Must be greater than 0.\n");
         clean_up();
         clean_up_json_result(json_result);
         (*read_data_parser_result)->status = WRONG_VALUE;
@@ -828,12 +904,12 @@ int handle_initial_fuel_in_tanker(int *initial_fuel_in_tanker, UserJsonResult **
     return 1;
 }
 
-int handle_fuel_transfer_rate(int *fuel_transfer_rate, UserJsonResult **json_result, ReadDataParserResult **read_data_parser_result)
+int handle_fuel_transfer_rate(int64_t *fuel_transfer_rate, UserJsonResult **json_result, ReadDataParserResult **read_data_parser_result)
 {
-    StatusType fuel_transfer_rate_result = get_int_value(json, fuel_transfer_rate, "fuel_transfer_rate");
+    StatusType fuel_transfer_rate_result = get_int64_value(&scenario_fields.fuel_transfer_rate, fuel_transfer_rate);
     if (fuel_transfer_rate_result == NOT_FOUND)
     {
-        printf("❌ [fuel_transfer_rate]: Field is required!\n");
+        parser_error("❌ [fuel_transfer_rate]: Field is required!\n");
         clean_up();
         clean_up_json_result(json_result);
         (*read_data_parser_result)->status = NOT_FOUND;
@@ -841,15 +917,23 @@ int handle_fuel_transfer_rate(int *fuel_transfer_rate, UserJsonResult **json_res
     }
     else if (fuel_transfer_rate_result == WRONG_TYPE)
     {
-        printf("❌ [fuel_transfer_rate]: Invalid value! Expected a number.\n");
+        parser_error("❌ [fuel_transfer_rate]: Invalid value! Expected a number.\n");
         clean_up();
         clean_up_json_result(json_result);
         (*read_data_parser_result)->status = WRONG_TYPE;
         return 0;
     }
-    else if ((*fuel_transfer_rate) > MAX_FUEL_TRANSFER_RATE)
+    else if (fuel_transfer_rate_result == MAX_VALUE_ERROR)
     {
-        printf("❌ [fuel_transfer_rate]: Must be less than or equal to the maximum limit of %d.\n", MAX_FUEL_TRANSFER_RATE);
+        parser_error("❌ [fuel_transfer_rate]: Value is out of range.\n");
+        clean_up();
+        clean_up_json_result(json_result);
+        (*read_data_parser_result)->status = MAX_VALUE_ERROR;
+        return 0;
+    }
+    else if ((*fuel_transfer_rate) > scenario_limits.max_fuel_transfer_rate)
+    {
+        parser_error("❌ [fuel_transfer_rate]: Must be less than or equal to the maximum limit of %" PRId64 ".\n", scenario_limits.max_fuel_transfer_rate);
         clean_up();
         clean_up_json_result(json_result);
         (*read_data_parser_result)->status = MAX_VALUE_ERROR;
@@ -857,7 +941,7 @@ int handle_fuel_transfer_rate(int *fuel_transfer_rate, UserJsonResult **json_res
     }
     else if ((*fuel_transfer_rate) <= 0)
     {
-        printf("❌ [fuel_transfer_rate]: Must be greater than 0.\n");
+        parser_error("❌ [fuel_transfer_rate]: Must be greater than 0.\n");
         clean_up();
         clean_up_json_result(json_result);
         (*read_data_parser_result)->status = WRONG_VALUE;
@@ -869,7 +953,7 @@ int handle_fuel_transfer_rate(int *fuel_transfer_rate, UserJsonResult **json_res
     {
         if (SHOW_LOGS)
         {
-            printf(
+            parser_printf(
                 "🚨 [fuel_transfer_rate]: can not be bigger than [initial_fuel_in_tanker].\n"
                 "🚨 Setting [fuel_transfer_rate] to [initial_fuel_in_tanker]...\n");
         }
@@ -878,19 +962,12 @@ int handle_fuel_transfer_rate(int *fuel_transfer_rate, UserJsonResult **json_res
     return 1;
 }
 
-int handle_get_file_buffer(char *path, ReadDataParserResult **read_data_parser_result)
+int handle_open_tokenizer(char *path, ReadDataParserResult **read_data_parser_result)
 {
-    StatusType get_file_buffer_result = get_file_buffer(&buffer, path);
-    if (get_file_buffer_result == ALLOCATION_ERROR)
-    {
-        printf("❌ Unable to allocate memory for [buffer].\n");
-        clean_up();
-        (*read_data_parser_result)->status = ALLOCATION_ERROR;
-        return 0;
-    }
-    if (get_file_buffer_result == UNKNOWN_ERROR)
+    tokenizer = json_tokenizer_open(path);
+    if (tokenizer == NULL)
     {
-        printf("❌ Unable to get file [buffer].\n");
+        parser_error("❌ Unable to open '%s': %s\n", path, strerror(errno));
         clean_up();
         (*read_data_parser_result)->status = UNKNOWN_ERROR;
         return 0;
@@ -898,13 +975,14 @@ int handle_get_file_buffer(char *path, ReadDataParserResult **read_data_parser_r
     return 1;
 }
 
-int handle_parse_file_buffer(ReadDataParserResult **read_data_parser_result)
+int handle_parse_scenario(UserJsonResult **json_result, ReadDataParserResult **read_data_parser_result)
 {
-    StatusType parse_file_buffer_result = parse_file_buffer(&json, &buffer);
-    if (parse_file_buffer_result == UNKNOWN_ERROR)
+    StatusType parse_scenario_result = parse_scenario((*json_result));
+    if (parse_scenario_result == UNKNOWN_ERROR)
     {
-        printf("❌ Unable to parse [buffer]\n");
+        parser_error("❌ Unable to parse the file.\n");
         clean_up();
+        clean_up_json_result(json_result);
         (*read_data_parser_result)->status = UNKNOWN_ERROR;
         return 0;
     }
@@ -916,20 +994,19 @@ int handle_result_vehicles(UserJsonResult **json_result, ReadDataParserResult **
     (*read_data_parser_result)->json_result = *json_result;
     (*read_data_parser_result)->status = CORRECT_VALUE;
 
-    (*json_result)->result_vehicles = (*json_result)->all_vehicles;
     (*json_result)->result_vehicles_length = (*json_result)->all_vehicles_length;
 
     if (SHOW_LOGS)
     {
-        // printf("\n");
-        // printf("✅ [vehicles] number of all vehicles: %d\n", (*json_result)->all_vehicles_length);
-        // printf("\n");
+        // parser_printf("\n");
+        // parser_printf("✅ [vehicles] number of all vehicles: %d\n", (*json_result)->all_vehicles_length);
+        // parser_printf("\n");
     }
-    if ((*json_result)->all_vehicles_length > MAX_VEHICLES)
+    if ((*json_result)->all_vehicles_length > scenario_limits.max_vehicles)
     {
         if (SHOW_LOGS)
         {
-            printf("❌ [vehicles]: Must be less than or equal to the maximum limit of %d.\n", MAX_VEHICLES);
+            parser_error("❌ [vehicles]: Must be less than or equal to the maximum limit of %" PRId64 ".\n", scenario_limits.max_vehicles);
         }
     }
 
@@ -938,7 +1015,7 @@ int handle_result_vehicles(UserJsonResult **json_result, ReadDataParserResult **
     {
         if (SHOW_LOGS)
         {
-            printf("❌ [vehicles]: Must be less than or equal to %d (max_vehicle_capacity).\n", (*json_result)->max_vehicle_capacity);
+            parser_error("❌ [vehicles]: Must be less than or equal to %" PRId64 " (max_vehicle_capacity).\n", (*json_result)->max_vehicle_capacity);
         }
         (*json_result)->result_vehicles_length = (*json_result)->max_vehicle_capacity;
     }
@@ -946,7 +1023,7 @@ int handle_result_vehicles(UserJsonResult **json_result, ReadDataParserResult **
     {
         if (SHOW_LOGS)
         {
-            printf("✅ Program will use %d vehicles out of the %d max specified.\n",
+            parser_printf("✅ Program will use %" PRId64 " vehicles out of the %" PRId64 " max specified.\n",
                    (*json_result)->all_vehicles_length,
                    (*json_result)->max_vehicle_capacity);
         }
@@ -955,41 +1032,29 @@ int handle_result_vehicles(UserJsonResult **json_result, ReadDataParserResult **
 
     if (SHOW_LOGS)
     {
-        printf("\n");
-        printf("✅ The final count of vehicles program will use is: %d\n", (*json_result)->result_vehicles_length);
-        printf("\n");
+        parser_printf("\n");
+        parser_printf("✅ The final count of vehicles program will use is: %" PRId64 "\n", (*json_result)->result_vehicles_length);
+        parser_printf("\n");
     }
 
     if ((*json_result)->randomize_arrival == 1)
     {
+        // Vehicles are drawn from the groups while iterating, only the draw order is fixed here
+        (*json_result)->random_seed = (uint64_t)time(NULL);
         if (SHOW_LOGS)
         {
-            printf("✅ Program is going to randomize %d vehicles list...\n", (*json_result)->result_vehicles_length);
-        }
-        if (handle_randomize_vehicles(json_result, read_data_parser_result) == 0)
-        {
-            return 0;
-        }
-        if (SHOW_LOGS)
-        {
-            printf("✅ Successfully randomized vehicles\n");
+            parser_printf("✅ %" PRId64 " vehicles will arrive in random order (seed %" PRIu64 ").\n",
+                          (*json_result)->result_vehicles_length, (*json_result)->random_seed);
         }
     }
     else
     {
         if (is_overlap_vehicle_length)
         {
+            // The iterator stops after them, nothing is copied
             if (SHOW_LOGS)
             {
-                printf("✅ Program is going to select first %d vehicles...\n", (*json_result)->result_vehicles_length);
-            }
-            if (handle_get_limited_amount(json_result, read_data_parser_result) == 0)
-            {
-                return 0;
-            }
-            if (SHOW_LOGS)
-            {
-                printf("✅ Successfully selected first %d vehicles\n", (*json_result)->result_vehicles_length);
+                parser_printf("✅ The first %" PRId64 " vehicles in file order will arrive, the rest are ignored.\n", (*json_result)->result_vehicles_length);
             }
         }
     }
@@ -999,10 +1064,10 @@ int handle_result_vehicles(UserJsonResult **json_result, ReadDataParserResult **
 
 int handle_get_all_vehicles(UserJsonResult **json_result, ReadDataParserResult **read_data_parser_result)
 {
-    StatusType vehicles_result = get_all_vehicles(json, *json_result);
+    StatusType vehicles_result = scenario_fields.vehicles_status;
     if (vehicles_result == VALIDATION_ERROR)
     {
-        printf("❌ [vehicles]: Validation was failed.\n");
+        parser_error("❌ [vehicles]: Validation was failed.\n");
         clean_up();
         clean_up_json_result(json_result);
         (*read_data_parser_result)->status = VALIDATION_ERROR;
@@ -1010,7 +1075,7 @@ int handle_get_all_vehicles(UserJsonResult **json_result, ReadDataParserResult *
     }
     if (vehicles_result == NOT_FOUND)
     {
-        printf("❌ [vehicles]: Field is required!\n");
+        parser_error("❌ [vehicles]: Field is required!\n");
         clean_up();
         clean_up_json_result(json_result);
         (*read_data_parser_result)->status = NOT_FOUND;
@@ -1018,7 +1083,7 @@ int handle_get_all_vehicles(UserJsonResult **json_result, ReadDataParserResult *
     }
     if (vehicles_result == WRONG_TYPE)
     {
-        printf("❌ [vehicles]: Invalid value! Expected an array.\n");
+        parser_error("❌ [vehicles]: Invalid value! Expected an array.\n");
         clean_up();
         clean_up_json_result(json_result);
         (*read_data_parser_result)->status = WRONG_TYPE;
@@ -1026,7 +1091,7 @@ int handle_get_all_vehicles(UserJsonResult **json_result, ReadDataParserResult *
     }
     if (vehicles_result == EMPTY_VALUE)
     {
-        printf("❌ [vehicles]: Is empty. Must contain at least one valid object.\n");
+        parser_error("❌ [vehicles]: Is empty. Must contain at least one valid object.\n");
         clean_up();
         clean_up_json_result(json_result);
         (*read_data_parser_result)->status = EMPTY_VALUE;
@@ -1034,7 +1099,7 @@ int handle_get_all_vehicles(UserJsonResult **json_result, ReadDataParserResult *
     }
     if (vehicles_result == EMPTY_VEHICLE_CAPACITY_VALUE)
     {
-        printf("❌ [vehicles]: Does not have any valid object. Must contain at least one valid object.\n");
+        parser_error("❌ [vehicles]: Does not have any valid object. Must contain at least one valid object.\n");
         clean_up();
         clean_up_json_result(json_result);
         (*read_data_parser_result)->status = EMPTY_VEHICLE_CAPACITY_VALUE;
@@ -1042,12 +1107,20 @@ int handle_get_all_vehicles(UserJsonResult **json_result, ReadDataParserResult *
     }
     if (vehicles_result == ALLOCATION_ERROR)
     {
-        printf("❌ [vehicles]: Unable to allocate memory.\n");
+        parser_error("❌ [vehicles]: Unable to allocate memory.\n");
         clean_up();
         clean_up_json_result(json_result);
         (*read_data_parser_result)->status = ALLOCATION_ERROR;
         return 0;
     }
+    if (vehicles_result == MAX_VEHICLES_ERROR)
+    {
+        parser_error("❌ [vehicles]: Too many vehicles.\n");
+        clean_up();
+        clean_up_json_result(json_result);
+        (*read_data_parser_result)->status = MAX_VEHICLES_ERROR;
+        return 0;
+    }
     return 1;
 }
 
@@ -1057,380 +1130,605 @@ int handle_get_all_vehicles(UserJsonResult **json_result, ReadDataParserResult *
 
 // ============
 
-StatusType validate_vehicles(cJSON *vehicles_array_p, int *all_vehicles_length, int *valid_indexes)
+static int append_vehicle_group(UserJsonResult *json_result, VehicleType vehicle_type, int fuel_needed, int wait_time_sec, int64_t count)
 {
-    if (SHOW_LOGS)
+    if (is_vehicle_allocation_failed || is_vehicle_count_overflow)
     {
-        printf("✅ Program running validation...\n");
+        return 0;
     }
-    cJSON *vehicle_p = NULL;
-    int index = 0;
-    my_cJSON_ArrayForEach(vehicle_p, vehicles_array_p, index)
+    if (count > INT64_MAX - json_result->all_vehicles_length)
     {
-        if (SHOW_LOGS)
-        {
-            printf("\n");
-            printf("\n");
-        }
-        // printf("Vehicle array item #%d\n", index);
-        valid_indexes[index] = 0;
-        if (SHOW_LOGS)
+        parser_error("❌ [vehicles]: Total count of vehicles does not fit in 64 bits.\n");
+        is_vehicle_count_overflow = true;
+        return 0;
+    }
+    if (json_result->vehicle_groups_length == vehicle_groups_capacity)
+    {
+        int new_capacity = vehicle_groups_capacity == 0 ? 16 : vehicle_groups_capacity * 2;
+        VehicleGroup *new_groups = (VehicleGroup *)realloc(json_result->vehicle_groups, new_capacity * sizeof(VehicleGroup));
+        if (new_groups == NULL)
         {
-            // printf("--------------------------------------------- --------------- Level 1: START\n");
+            parser_error("❌ Memory allocation on vehicle groups list failed.\n");
+            is_vehicle_allocation_failed = true;
+            return 0;
         }
+        json_result->vehicle_groups = new_groups;
+        vehicle_groups_capacity = new_capacity;
+    }
 
-        VehicleType vehicle_type = get_vehicle_type(vehicle_p, true, index);
-        if (vehicle_type == VEHICLE_NOT_FOUND)
-        {
-            continue;
-        }
+    VehicleGroup *new_group = &json_result->vehicle_groups[json_result->vehicle_groups_length];
+    // Groups are written to compiled scenarios as is, so the padding before [count] must not be heap garbage
+    memset(new_group, 0, sizeof(VehicleGroup));
+    new_group->vehicle_type = vehicle_type;
+    new_group->fuel_needed = fuel_needed;
+    new_group->wait_time_sec = wait_time_sec;
+    new_group->count = count;
+    json_result->vehicle_groups_length++;
+    json_result->all_vehicles_length += count;
+    return 1;
+}
 
-        int default_fuel_needed = 0;
-        if (get_default_fuel_needed(vehicle_p, &default_fuel_needed, true) == 0)
-        {
-            continue;
-        }
+static void drop_vehicle_groups_from(UserJsonResult *json_result, const VehicleEntry *vehicle_entry)
+{
+    if (json_result->vehicle_groups_length > vehicle_entry->first_group_index)
+    {
+        json_result->vehicle_groups_length = vehicle_entry->first_group_index;
+        json_result->all_vehicles_length = vehicle_entry->first_vehicle_index;
+    }
+}
 
-        int default_wait_time_sec = 0;
-        if (get_default_wait_time_sec(vehicle_p, &default_wait_time_sec, true) == 0)
-        {
-            continue;
-        }
+static uint64_t mix_bits(uint64_t z)
+{
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
 
-        int default_count = 0;
-        if (get_default_count(vehicle_p, &default_count, true) == 0)
-        {
-            continue;
-        }
+// splitmix64, the iterator needs its own reproducible sequence
+static uint64_t next_random(uint64_t *state)
+{
+    return mix_bits(*state += 0x9E3779B97F4A7C15ULL);
+}
 
-        int local_vehicle_capacity = 0;
-        StatusType custom_waiting_list_result = validate_custom_waiting_list(vehicle_p, &local_vehicle_capacity, true);
-        if (custom_waiting_list_result == NOT_FOUND)
+// Slots only pay off while most of them hold a vehicle, one huge group among small ones would leave them nearly empty
+static int init_slot_permutation(VehicleIterator *vehicle_iterator)
+{
+    int64_t largest_group = 0;
+    for (int i = 0; i < vehicle_iterator->groups_length; i++)
+    {
+        if (vehicle_iterator->groups[i].count > largest_group)
         {
-            if (SHOW_LOGS)
-            {
-                printf("   └─ ❌ Custom list was not found. Using default values.\n");
-            }
-            local_vehicle_capacity += default_count;
+            largest_group = vehicle_iterator->groups[i].count;
         }
-        if (custom_waiting_list_result == EMPTY_VALUE)
+    }
+    if (largest_group == 0 || largest_group > (int64_t)((1ULL << 62) / (uint64_t)vehicle_iterator->groups_length) ||
+        (double)vehicle_iterator->groups_length * largest_group > VEHICLE_ITERATOR_MAX_SLOTS_PER_VEHICLE * (double)vehicle_iterator->remaining_total)
+    {
+        return 0;
+    }
+
+    vehicle_iterator->slots_per_group = largest_group;
+    vehicle_iterator->slots_count = (uint64_t)vehicle_iterator->groups_length * (uint64_t)largest_group;
+    vehicle_iterator->half_bits = 1;
+    while ((1ULL << (2 * vehicle_iterator->half_bits)) < vehicle_iterator->slots_count)
+    {
+        vehicle_iterator->half_bits++;
+    }
+    for (int i = 0; i < VEHICLE_ITERATOR_ROUNDS; i++)
+    {
+        vehicle_iterator->round_keys[i] = next_random(&vehicle_iterator->random_state);
+    }
+    return 1;
+}
+
+// Feistel network over [0, 4^half_bits); walking the cycle until the value is back in range
+// keeps it a bijection on [0, slots_count), which needs at most 4 passes on average
+static uint64_t permute_slot(const VehicleIterator *vehicle_iterator, uint64_t position)
+{
+    int half_bits = vehicle_iterator->half_bits;
+    uint64_t mask = (1ULL << half_bits) - 1;
+    do
+    {
+        uint64_t left = position >> half_bits;
+        uint64_t right = position & mask;
+        for (int i = 0; i < VEHICLE_ITERATOR_ROUNDS; i++)
         {
-            if (SHOW_LOGS)
-            {
-                printf("   └─ ❌ Custom list is empty. Using default values.\n");
-            }
-            local_vehicle_capacity += default_count;
+            uint64_t next_right = left ^ (mix_bits(right ^ vehicle_iterator->round_keys[i]) & mask);
+            left = right;
+            right = next_right;
         }
-        if (custom_waiting_list_result == WRONG_TYPE)
+        position = (left << half_bits) | right;
+    } while (position >= vehicle_iterator->slots_count);
+    return position;
+}
+
+int vehicle_iterator_init(VehicleIterator *vehicle_iterator, const UserJsonResult *json_result)
+{
+    vehicle_iterator->groups = json_result->vehicle_groups;
+    vehicle_iterator->groups_length = json_result->vehicle_groups_length;
+    vehicle_iterator->remaining = json_result->result_vehicles_length;
+    vehicle_iterator->group_index = 0;
+    vehicle_iterator->used_in_group = 0;
+    vehicle_iterator->remaining_total = json_result->all_vehicles_length;
+    vehicle_iterator->random_state = json_result->random_seed;
+    vehicle_iterator->slots_per_group = 0;
+    vehicle_iterator->slots_count = 0;
+    vehicle_iterator->slot_position = 0;
+    vehicle_iterator->half_bits = 0;
+    vehicle_iterator->remaining_counts = NULL;
+    vehicle_iterator->highest_step = 0;
+    if (!json_result->randomize_arrival || init_slot_permutation(vehicle_iterator))
+    {
+        return 1;
+    }
+
+    int length = vehicle_iterator->groups_length;
+    int64_t *remaining_counts = (int64_t *)calloc(length + 1, sizeof(int64_t));
+    if (remaining_counts == NULL)
+    {
+        parser_error("❌ Unable to allocate memory for vehicle iterator.\n");
+        return 0;
+    }
+    for (int i = 1; i <= length; i++)
+    {
+        remaining_counts[i] += vehicle_iterator->groups[i - 1].count;
+        int parent = i + (i & -i);
+        if (parent <= length)
         {
-            if (SHOW_LOGS)
-            {
-                printf("   └─ ❌ Custom list is not array\n");
-            }
-            continue;
+            remaining_counts[parent] += remaining_counts[i];
         }
-        if (custom_waiting_list_result == WRONG_VALUE)
+    }
+    vehicle_iterator->highest_step = 1;
+    while (vehicle_iterator->highest_step * 2 <= length)
+    {
+        vehicle_iterator->highest_step *= 2;
+    }
+    vehicle_iterator->remaining_counts = remaining_counts;
+    return 1;
+}
+
+// Every slot is visited once, so a vehicle is left in one of the slots ahead while [remaining_total] > 0
+static int draw_slot_group(VehicleIterator *vehicle_iterator)
+{
+    while (true)
+    {
+        uint64_t slot = permute_slot(vehicle_iterator, vehicle_iterator->slot_position++);
+        int group_index = (int)(slot / (uint64_t)vehicle_iterator->slots_per_group);
+        if ((int64_t)(slot % (uint64_t)vehicle_iterator->slots_per_group) < vehicle_iterator->groups[group_index].count)
         {
-            if (SHOW_LOGS)
-            {
-                // printf("\n");
-                printf("   ❌ Did not find valid vehicles. Using default values.\n");
-                printf("   ✅ Total valid vehicles in this entry: %d\n", default_count);
-                // printf("--------------------------------------------- --------------- Level 1: END\n");
-            }
-            local_vehicle_capacity += default_count;
+            vehicle_iterator->remaining_total--;
+            return group_index;
         }
-        else
+    }
+}
+
+// Picks a group with probability proportional to its remaining vehicles and takes one from it
+static int draw_random_group(VehicleIterator *vehicle_iterator)
+{
+    int64_t *remaining_counts = vehicle_iterator->remaining_counts;
+    int length = vehicle_iterator->groups_length;
+    int64_t target = (int64_t)(next_random(&vehicle_iterator->random_state) % (uint64_t)vehicle_iterator->remaining_total);
+    int position = 0;
+    for (int step = vehicle_iterator->highest_step; step > 0; step /= 2)
+    {
+        if (position + step <= length && remaining_counts[position + step] <= target)
         {
-            if (SHOW_LOGS)
-            {
-                // printf("\n");
-                printf("   ✅ Total valid vehicles in this entry: %d\n", local_vehicle_capacity);
-                // printf("--------------------------------------------- --------------- Level 1: END\n");
-            }
+            position += step;
+            target -= remaining_counts[position];
         }
-        *all_vehicles_length += local_vehicle_capacity;
-        valid_indexes[index] = 1;
     }
-
-    return CORRECT_VALUE;
+    for (int i = position + 1; i <= length; i += i & -i)
+    {
+        remaining_counts[i]--;
+    }
+    vehicle_iterator->remaining_total--;
+    return position;
 }
 
-StatusType validate_custom_waiting_list(cJSON *json, int *local_vehicle_capacity, _Bool show_logs_now)
+int vehicle_iterator_next(VehicleIterator *vehicle_iterator, Vehicle *vehicle)
 {
-    cJSON *custom_waiting_list_p = NULL;
-    StatusType custom_waiting_list_result = get_array_value(json, (void **)&custom_waiting_list_p, "custom_waiting_list");
-    if (custom_waiting_list_result == NOT_FOUND)
+    if (vehicle_iterator->remaining <= 0 || vehicle_iterator->remaining_total <= 0)
     {
-        return NOT_FOUND;
+        return 0;
     }
-    else if (custom_waiting_list_result == WRONG_TYPE)
+
+    int group_index = 0;
+    if (vehicle_iterator->slots_per_group > 0)
     {
-        return WRONG_TYPE;
+        group_index = draw_slot_group(vehicle_iterator);
+    }
+    else if (vehicle_iterator->remaining_counts != NULL)
+    {
+        group_index = draw_random_group(vehicle_iterator);
+    }
+    else
+    {
+        while (vehicle_iterator->used_in_group >= vehicle_iterator->groups[vehicle_iterator->group_index].count)
+        {
+            vehicle_iterator->group_index++;
+            vehicle_iterator->used_in_group = 0;
+        }
+        vehicle_iterator->used_in_group++;
+        vehicle_iterator->remaining_total--;
+        group_index = vehicle_iterator->group_index;
     }
 
-    int custom_waiting_list_length = cJSON_GetArraySize(custom_waiting_list_p);
-    if (custom_waiting_list_length == 0)
+    const VehicleGroup *group = &vehicle_iterator->groups[group_index];
+    vehicle->vehicle_type = group->vehicle_type;
+    vehicle->fuel_needed = group->fuel_needed;
+    vehicle->wait_time_sec = group->wait_time_sec;
+    vehicle_iterator->remaining--;
+    return 1;
+}
+
+void vehicle_iterator_close(VehicleIterator *vehicle_iterator)
+{
+    free(vehicle_iterator->remaining_counts);
+    vehicle_iterator->remaining_counts = NULL;
+    vehicle_iterator->remaining = 0;
+}
+
+// Type and defaults of an entry, checked (and logged) in the same order as before
+static int validate_vehicle_entry_header(const VehicleEntry *vehicle_entry, int index, _Bool show_logs_now)
+{
+    int value = 0;
+    int64_t count = 0;
+    return get_vehicle_type(vehicle_entry, show_logs_now, index) != VEHICLE_NOT_FOUND &&
+           get_default_fuel_needed(&vehicle_entry->default_fuel_needed, &value, show_logs_now) &&
+           get_default_wait_time_sec(&vehicle_entry->default_wait_time_sec, &value, show_logs_now) &&
+           get_default_count(&vehicle_entry->default_count, &count, show_logs_now);
+}
+
+StatusType parse_custom_waiting_list(UserJsonResult *json_result, VehicleEntry *vehicle_entry, int index)
+{
+    JsonTokenType type = json_tokenizer_next(tokenizer);
+    if (vehicle_entry->custom_waiting_list_status != NOT_FOUND)
+    {
+        return skip_started_value(type) ? CORRECT_VALUE : UNKNOWN_ERROR;
+    }
+    if (type != JSON_TOKEN_BEGIN_ARRAY)
     {
-        return EMPTY_VALUE;
+        vehicle_entry->custom_waiting_list_status = WRONG_TYPE;
+        return skip_started_value(type) ? CORRECT_VALUE : UNKNOWN_ERROR;
     }
 
-    if (SHOW_LOGS && show_logs_now)
+    // Items are logged as they are read, so log the entry first if everything it needs is already known
+    _Bool show_logs_now = SHOW_LOGS;
+    if (SHOW_LOGS && vehicle_entry->vehicle_type_status != NOT_FOUND && vehicle_entry->default_fuel_needed.status != NOT_FOUND &&
+        vehicle_entry->default_wait_time_sec.status != NOT_FOUND && vehicle_entry->default_count.status != NOT_FOUND)
     {
-        printf("   └─ ✅ Custom list (%d items):\n", custom_waiting_list_length);
+        vehicle_entry->is_header_logged = true;
+        vehicle_entry->is_header_valid = validate_vehicle_entry_header(vehicle_entry, index, true);
+        show_logs_now = vehicle_entry->is_header_valid;
     }
 
-    cJSON *custom_waiting_list_item_p = NULL;
-    int index = 0;
-    my_cJSON_ArrayForEach(custom_waiting_list_item_p, custom_waiting_list_p, index)
+    int items_count = 0;
+    int64_t local_vehicle_capacity = 0;
+    while ((type = json_tokenizer_next(tokenizer)) != JSON_TOKEN_END_ARRAY)
     {
-        if (SHOW_LOGS && show_logs_now)
-        {
-            // printf("\n");
-            // printf("--------------------------------Level 2: START\n");
-            printf("       ─ Item #%d:\n", index);
-        }
-        int fuel_needed = 0;
-        StatusType fuel_needed_result = get_custom_waiting_list_fuel_needed(custom_waiting_list_item_p, &fuel_needed, true);
-        if (fuel_needed_result == WRONG_TYPE)
+        CustomItemFields item_fields;
+        init_int_field(&item_fields.fuel_needed);
+        init_int_field(&item_fields.wait_time_sec);
+        init_int_field(&item_fields.count);
+
+        if (type == JSON_TOKEN_BEGIN_OBJECT)
         {
-            continue;
+            while ((type = json_tokenizer_next(tokenizer)) == JSON_TOKEN_KEY)
+            {
+                if (read_field(find_field(&custom_item_field_table), &item_fields) == 0)
+                {
+                    return UNKNOWN_ERROR;
+                }
+            }
+            if (type != JSON_TOKEN_END_OBJECT)
+            {
+                return UNKNOWN_ERROR;
+            }
         }
-        if (fuel_needed_result == WRONG_VALUE)
+        else if (skip_started_value(type) == 0)
         {
-            continue;
+            return UNKNOWN_ERROR;
         }
 
-        int wait_time_sec = 0;
-        StatusType wait_time_sec_result = get_custom_waiting_list_wait_time_sec(custom_waiting_list_item_p, &wait_time_sec, true);
-        if (wait_time_sec_result == WRONG_TYPE)
+        if (show_logs_now)
         {
-            continue;
+            if (items_count == 0)
+            {
+                parser_printf("   └─ ✅ Custom list:\n");
+            }
+            parser_printf("       ─ Item #%d:\n", items_count);
         }
-        if (wait_time_sec_result == WRONG_VALUE)
+        items_count++;
+
+        int fuel_needed = 0;
+        StatusType fuel_needed_result = get_custom_waiting_list_fuel_needed(&item_fields.fuel_needed, &fuel_needed, show_logs_now);
+        if (fuel_needed_result == WRONG_TYPE || fuel_needed_result == WRONG_VALUE || fuel_needed_result == MAX_VALUE_ERROR)
         {
             continue;
         }
 
-        int count = 0;
-        StatusType count_result = get_custom_waiting_list_count(custom_waiting_list_item_p, &count, true);
-        if (count_result != CORRECT_VALUE)
+        int wait_time_sec = 0;
+        StatusType wait_time_sec_result = get_custom_waiting_list_wait_time_sec(&item_fields.wait_time_sec, &wait_time_sec, show_logs_now);
+        if (wait_time_sec_result == WRONG_TYPE || wait_time_sec_result == WRONG_VALUE || wait_time_sec_result == MAX_VALUE_ERROR)
         {
             continue;
         }
 
-        (*local_vehicle_capacity) += count;
-        if (SHOW_LOGS && show_logs_now)
+        int64_t count = 0;
+        if (get_custom_waiting_list_count(&item_fields.count, &count, show_logs_now) != CORRECT_VALUE)
         {
-            // printf("--------------------------------Level 2: END\n");
+            continue;
         }
-    }
 
-    if ((*local_vehicle_capacity) == 0)
-    {
-        return WRONG_VALUE;
+        // Only checked against 0, saturate instead of wrapping
+        local_vehicle_capacity = count > INT64_MAX - local_vehicle_capacity ? INT64_MAX : local_vehicle_capacity + count;
+        append_vehicle_group(json_result,
+                             vehicle_entry->vehicle_type,
+                             fuel_needed_result == NOT_FOUND ? FUEL_NEEDED_FROM_DEFAULT : fuel_needed,
+                             wait_time_sec_result == NOT_FOUND ? WAIT_TIME_FROM_DEFAULT : wait_time_sec,
+                             count);
     }
 
-    return CORRECT_VALUE;
-}
-
-// ============
-
-//
-
-// ============
-
-StatusType get_all_vehicles(cJSON *json, UserJsonResult *json_result)
-{
-    cJSON *vehicles_array_p = NULL;
-    StatusType vehicles_array_result = get_array_value(json, (void **)&vehicles_array_p, "vehicles");
-
-    if (vehicles_array_result == NOT_FOUND)
+    if (items_count == 0)
     {
-        return NOT_FOUND;
+        vehicle_entry->custom_waiting_list_status = EMPTY_VALUE;
     }
-    else if (vehicles_array_result == WRONG_TYPE)
+    else if (local_vehicle_capacity == 0)
     {
-        return WRONG_TYPE;
+        vehicle_entry->custom_waiting_list_status = WRONG_VALUE;
     }
-    if (vehicles_array_p == NULL)
+    else
     {
-        return ALLOCATION_ERROR;
+        vehicle_entry->custom_waiting_list_status = CORRECT_VALUE;
     }
+    return CORRECT_VALUE;
+}
 
-    int vehicle_length = cJSON_GetArraySize(vehicles_array_p);
-    if (vehicle_length == 0)
-    {
-        return EMPTY_VALUE;
+StatusType parse_vehicle_entry(UserJsonResult *json_result, int index, _Bool *is_valid)
+{
+    VehicleEntry vehicle_entry;
+    vehicle_entry.vehicle_type_status = NOT_FOUND;
+    vehicle_entry.vehicle_type = VEHICLE_NOT_FOUND;
+    init_int_field(&vehicle_entry.default_fuel_needed);
+    init_int_field(&vehicle_entry.default_wait_time_sec);
+    init_int_field(&vehicle_entry.default_count);
+    vehicle_entry.custom_waiting_list_status = NOT_FOUND;
+    vehicle_entry.first_group_index = json_result->vehicle_groups_length;
+    vehicle_entry.first_vehicle_index = json_result->all_vehicles_length;
+    vehicle_entry.is_header_logged = false;
+    vehicle_entry.is_header_valid = false;
+    *is_valid = false;
+
+    JsonTokenType type = JSON_TOKEN_END_OBJECT;
+    while ((type = json_tokenizer_next(tokenizer)) == JSON_TOKEN_KEY)
+    {
+        const FieldDescriptor *field = find_field(&vehicle_entry_field_table);
+        int read_result = 0;
+        if (field != NULL && field->kind == FIELD_CUSTOM_WAITING_LIST)
+        {
+            read_result = parse_custom_waiting_list(json_result, &vehicle_entry, index) == CORRECT_VALUE;
+        }
+        else
+        {
+            read_result = read_field(field, &vehicle_entry);
+        }
+        if (read_result == 0)
+        {
+            return UNKNOWN_ERROR;
+        }
     }
-
-    if (SHOW_LOGS)
+    if (type != JSON_TOKEN_END_OBJECT)
     {
-        printf("\n");
-        printf("✅ Found %d [vehicles] objects\n", vehicle_length);
-        printf("\n");
+        return UNKNOWN_ERROR;
     }
 
-    int all_vehicles_length = 0;
-    int valid_indexes[vehicle_length];
-    StatusType vehicles_validation_result = validate_vehicles(vehicles_array_p, &all_vehicles_length, valid_indexes);
-    if (vehicles_validation_result != CORRECT_VALUE)
+    _Bool is_header_valid = vehicle_entry.is_header_logged ? vehicle_entry.is_header_valid : validate_vehicle_entry_header(&vehicle_entry, index, true);
+    StatusType custom_waiting_list_result = vehicle_entry.custom_waiting_list_status;
+    if (!is_header_valid || custom_waiting_list_result == WRONG_TYPE)
     {
-        return VALIDATION_ERROR;
+        if (is_header_valid && SHOW_LOGS)
+        {
+            parser_printf("   └─ ❌ Custom list is not array\n");
+        }
+        drop_vehicle_groups_from(json_result, &vehicle_entry);
+        return CORRECT_VALUE;
     }
-    if (all_vehicles_length == 0)
+
+    int default_fuel_needed = 0;
+    int default_wait_time_sec = 0;
+    int64_t default_count = 0;
+    get_int_value(&vehicle_entry.default_fuel_needed, &default_fuel_needed);
+    get_int_value(&vehicle_entry.default_wait_time_sec, &default_wait_time_sec);
+    get_int64_value(&vehicle_entry.default_count, &default_count);
+    if (custom_waiting_list_result == CORRECT_VALUE)
     {
-        return EMPTY_VEHICLE_CAPACITY_VALUE;
+        for (int i = vehicle_entry.first_group_index; i < json_result->vehicle_groups_length; i++)
+        {
+            VehicleGroup *group = &json_result->vehicle_groups[i];
+            group->vehicle_type = vehicle_entry.vehicle_type;
+            if (group->fuel_needed == FUEL_NEEDED_FROM_DEFAULT)
+            {
+                group->fuel_needed = default_fuel_needed;
+            }
+            if (group->wait_time_sec == WAIT_TIME_FROM_DEFAULT)
+            {
+                group->wait_time_sec = default_wait_time_sec;
+            }
+        }
     }
-
-    if (SHOW_LOGS)
+    else
     {
-        printf("\n");
-        printf("\n");
-        printf("📋 List of analyzed vehicle elements:\n");
-        printf("\n");
-        for (int i = 0; i < vehicle_length; i++)
+        if (SHOW_LOGS)
         {
-            if (valid_indexes[i] == 1)
+            if (custom_waiting_list_result == NOT_FOUND)
+            {
+                parser_printf("   └─ ❌ Custom list was not found. Using default values.\n");
+            }
+            if (custom_waiting_list_result == EMPTY_VALUE)
             {
-                printf("✅ [%2d] Valid.\n", i);
+                parser_printf("   └─ ❌ Custom list is empty. Using default values.\n");
             }
-            if (valid_indexes[i] == 0)
+            if (custom_waiting_list_result == WRONG_VALUE)
             {
-                printf("❌ [%2d] Invalid.\n", i);
+                parser_printf("   ❌ Did not find valid vehicles. Using default values.\n");
             }
         }
-        printf("\n");
-        printf("✅ Total %d valid vehicles was found\n", all_vehicles_length);
-        printf("\n");
+        append_vehicle_group(json_result, vehicle_entry.vehicle_type, default_fuel_needed, default_wait_time_sec, default_count);
     }
 
-    int count_added_vehicles = 0;
-    json_result->all_vehicles = (Vehicle **)malloc(all_vehicles_length * sizeof(Vehicle));
-    if (json_result->all_vehicles == NULL)
+    if (SHOW_LOGS)
     {
-        return ALLOCATION_ERROR;
+        parser_printf("   ✅ Total valid vehicles in this entry: %" PRId64 "\n", json_result->all_vehicles_length - vehicle_entry.first_vehicle_index);
     }
+    *is_valid = true;
+    return CORRECT_VALUE;
+}
 
-    json_result->all_vehicles_length = all_vehicles_length;
+// Reads the [vehicles] array, emitting vehicle groups as entries are read; only the group list grows with the file
+StatusType parse_vehicles(UserJsonResult *json_result)
+{
+    JsonTokenType type = json_tokenizer_next(tokenizer);
+    if (scenario_fields.vehicles_status != NOT_FOUND)
+    {
+        return skip_started_value(type) ? CORRECT_VALUE : UNKNOWN_ERROR;
+    }
+    if (type != JSON_TOKEN_BEGIN_ARRAY)
+    {
+        scenario_fields.vehicles_status = WRONG_TYPE;
+        return skip_started_value(type) ? CORRECT_VALUE : UNKNOWN_ERROR;
+    }
 
-    cJSON *vehicle_p = NULL;
+    if (SHOW_LOGS)
+    {
+        parser_printf("✅ Program running validation...\n");
+    }
     int index = 0;
-    my_cJSON_ArrayForEach(vehicle_p, vehicles_array_p, index)
+    int valid_entries_count = 0;
+    while ((type = json_tokenizer_next(tokenizer)) != JSON_TOKEN_END_ARRAY)
     {
-        if (valid_indexes[index] == 0)
+        if (SHOW_LOGS)
         {
-            if (SHOW_LOGS)
+            parser_printf("\n");
+            parser_printf("\n");
+        }
+
+        _Bool is_valid = false;
+        if (type == JSON_TOKEN_BEGIN_OBJECT)
+        {
+            if (parse_vehicle_entry(json_result, index, &is_valid) != CORRECT_VALUE)
             {
-                // printf("\n");
-                // printf("❌ [%d] Skipping...\n", index);
+                return UNKNOWN_ERROR;
             }
-            continue;
         }
         else
         {
-            if (SHOW_LOGS)
+            if (skip_started_value(type) == 0)
             {
-                // printf("\n");
-                // printf("✅ [%d] Processing...\n", index);
+                return UNKNOWN_ERROR;
             }
+            VehicleEntry empty_entry;
+            empty_entry.vehicle_type_status = NOT_FOUND;
+            get_vehicle_type(&empty_entry, true, index);
         }
-
         if (SHOW_LOGS)
         {
-            // printf("--------------------------------------------- --------------- Level 1: START\n");
-        }
-        VehicleType vehicle_type = get_vehicle_type(vehicle_p, false, index);
-        if (vehicle_type == VEHICLE_NOT_FOUND)
-        {
-            continue;
-        }
-
-        int default_fuel_needed = 0;
-        if (get_default_fuel_needed(vehicle_p, &default_fuel_needed, false) == 0)
-        {
-            continue;
+            parser_printf("%s [%2d] %s\n", is_valid ? "✅" : "❌", index, is_valid ? "Valid." : "Invalid.");
         }
+        valid_entries_count += is_valid;
+        index++;
+    }
 
-        int default_wait_time_sec = 0;
-        if (get_default_wait_time_sec(vehicle_p, &default_wait_time_sec, false) == 0)
-        {
-            continue;
-        }
+    if (SHOW_LOGS)
+    {
+        parser_printf("\n");
+        parser_printf("✅ Found %d [vehicles] objects, %d valid\n", index, valid_entries_count);
+        parser_printf("✅ Total %" PRId64 " valid vehicles was found\n", json_result->all_vehicles_length);
+        parser_printf("\n");
+    }
 
-        int default_count = 0;
-        if (get_default_count(vehicle_p, &default_count, false) == 0)
-        {
-            continue;
-        }
+    if (is_vehicle_allocation_failed)
+    {
+        scenario_fields.vehicles_status = ALLOCATION_ERROR;
+    }
+    else if (is_vehicle_count_overflow)
+    {
+        scenario_fields.vehicles_status = MAX_VEHICLES_ERROR;
+    }
+    else if (index == 0)
+    {
+        scenario_fields.vehicles_status = EMPTY_VALUE;
+    }
+    else if (json_result->all_vehicles_length == 0)
+    {
+        scenario_fields.vehicles_status = EMPTY_VEHICLE_CAPACITY_VALUE;
+    }
+    else
+    {
+        scenario_fields.vehicles_status = CORRECT_VALUE;
+    }
+    return CORRECT_VALUE;
+}
 
-        StatusType custom_waiting_list_result = get_custom_waiting_list(
-            vehicle_p,
-            vehicle_type,
-            default_wait_time_sec,
-            default_fuel_needed,
-            json_result->all_vehicles,
-            &count_added_vehicles,
-            false);
+// Single pass over the document: top-level scalars are kept for the checks, vehicles are emitted right away
+StatusType parse_scenario(UserJsonResult *json_result)
+{
+    init_int_field(&scenario_fields.fuel_pumps_count);
+    init_int_field(&scenario_fields.max_vehicle_capacity);
+    init_int_field(&scenario_fields.initial_fuel_in_tanker);
+    init_int_field(&scenario_fields.fuel_transfer_rate);
+    scenario_fields.randomize_arrival.status = NOT_FOUND;
+    scenario_fields.randomize_arrival.value = false;
+    scenario_fields.vehicles_status = NOT_FOUND;
+    vehicle_groups_capacity = 0;
+    is_vehicle_allocation_failed = false;
+    is_vehicle_count_overflow = false;
+    pthread_once(&field_tables_once, build_field_tables);
 
-        if (custom_waiting_list_result == WRONG_TYPE)
+    JsonTokenType type = json_tokenizer_next(tokenizer);
+    // Anything but an object has none of the fields
+    if (type != JSON_TOKEN_BEGIN_OBJECT)
+    {
+        if (skip_started_value(type) == 0)
         {
-            if (SHOW_LOGS)
-            {
-                // printf("❌ [custom_waiting_list] is not array\n");
-            }
-            continue;
+            parser_error("❌ Error on parse JSON: %s\n", tokenizer->error);
+            return UNKNOWN_ERROR;
         }
-        if (custom_waiting_list_result == EMPTY_VALUE || custom_waiting_list_result == NOT_FOUND || custom_waiting_list_result == WRONG_VALUE)
-        {
-            for (int i = 0; i < default_count; i++)
-            {
-                Vehicle *new_vehicle = (Vehicle *)malloc(sizeof(Vehicle));
-                if (new_vehicle == NULL)
-                {
-                    printf("❌ Memory allocation on new vehicle failed\n");
-                    continue;
-                }
-                new_vehicle->vehicle_type = vehicle_type;
-                new_vehicle->fuel_needed = default_fuel_needed;
-                new_vehicle->wait_time_sec = default_wait_time_sec;
+        return CORRECT_VALUE;
+    }
 
-                json_result->all_vehicles[count_added_vehicles] = new_vehicle;
-                count_added_vehicles++;
-            }
-        }
-        if (custom_waiting_list_result == EMPTY_VALUE)
+    while ((type = json_tokenizer_next(tokenizer)) == JSON_TOKEN_KEY)
+    {
+        const FieldDescriptor *field = find_field(&scenario_field_table);
+        int read_result = 0;
+        if (field != NULL && field->kind == FIELD_VEHICLES)
         {
-            if (SHOW_LOGS)
-            {
-                // printf("❌ [custom_waiting_list] is empty\n");
-            }
+            read_result = parse_vehicles(json_result) == CORRECT_VALUE;
         }
-        if (custom_waiting_list_result == NOT_FOUND)
+        else
         {
-            if (SHOW_LOGS)
-            {
-                // printf("❌ [custom_waiting_list] was not found. Field is required!\n");
-            }
+            read_result = read_field(field, &scenario_fields);
         }
-
-        if (SHOW_LOGS)
+        if (read_result == 0)
         {
-            // printf("--------------------------------------------- --------------- Level 1: END\n");
+            break;
         }
     }
-
+    if (type != JSON_TOKEN_END_OBJECT)
+    {
+        parser_error("❌ Error on parse JSON: %s\n", tokenizer->error);
+        return UNKNOWN_ERROR;
+    }
     return CORRECT_VALUE;
 }
 
-int get_default_fuel_needed(cJSON *vehicle_p, int *default_fuel_needed, _Bool show_logs_now)
+int get_default_fuel_needed(const IntField *field, int *default_fuel_needed, _Bool show_logs_now)
 {
-    StatusType default_fuel_needed_result = get_int_value(vehicle_p, default_fuel_needed, "default_fuel_needed");
+    StatusType default_fuel_needed_result = get_int_value(field, default_fuel_needed);
     if (default_fuel_needed_result == NOT_FOUND)
     {
         if (SHOW_LOGS && show_logs_now)
         {
-            printf("   └─ ❌ Default fuel: Field is required!\n");
+            parser_printf("   └─ ❌ Default fuel: Field is required!\n");
         }
         return 0;
     }
@@ -1438,7 +1736,15 @@ int get_default_fuel_needed(cJSON *vehicle_p, int *default_fuel_needed, _Bool sh
     {
         if (SHOW_LOGS && show_logs_now)
         {
-            printf("   └─ ❌ Default fuel: Invalid value! Expected a number.\n");
+            parser_printf("   └─ ❌ Default fuel: Invalid value! Expected a number.\n");
+        }
+        return 0;
+    }
+    else if (default_fuel_needed_result == MAX_VALUE_ERROR)
+    {
+        if (SHOW_LOGS && show_logs_now)
+        {
+            parser_printf("   └─ ❌ Default fuel: Value is out of range.\n");
         }
         return 0;
     }
@@ -1446,7 +1752,7 @@ int get_default_fuel_needed(cJSON *vehicle_p, int *default_fuel_needed, _Bool sh
     {
         if (SHOW_LOGS && show_logs_now)
         {
-            printf("   └─ ❌ Default fuel: Must be a positive number.\n");
+            parser_printf("   └─ ❌ Default fuel: Must be a positive number.\n");
         }
         return 0;
     }
@@ -1454,25 +1760,25 @@ int get_default_fuel_needed(cJSON *vehicle_p, int *default_fuel_needed, _Bool sh
     {
         if (SHOW_LOGS && show_logs_now)
         {
-            printf("   └─ ❌ Default fuel: Cannot be zero.\n");
+            parser_printf("   └─ ❌ Default fuel: Cannot be zero.\n");
         }
         return 0;
     }
     if (SHOW_LOGS && show_logs_now)
     {
-        printf("   ├─ ✅ Default fuel: %d\n", *default_fuel_needed);
+        parser_printf("   ├─ ✅ Default fuel: %d\n", *default_fuel_needed);
     }
     return 1;
 }
 
-int get_default_wait_time_sec(cJSON *vehicle_p, int *default_wait_time_sec, _Bool show_logs_now)
+int get_default_wait_time_sec(const IntField *field, int *default_wait_time_sec, _Bool show_logs_now)
 {
-    StatusType default_wait_time_sec_result = get_int_value(vehicle_p, default_wait_time_sec, "default_wait_time_sec");
+    StatusType default_wait_time_sec_result = get_int_value(field, default_wait_time_sec);
     if (default_wait_time_sec_result == NOT_FOUND)
     {
         if (SHOW_LOGS && show_logs_now)
         {
-            printf("   └─ ❌ Default wait time: Field is required!\n");
+            parser_printf("   └─ ❌ Default wait time: Field is required!\n");
         }
         return 0;
     }
@@ -1480,7 +1786,15 @@ int get_default_wait_time_sec(cJSON *vehicle_p, int *default_wait_time_sec, _Boo
     {
         if (SHOW_LOGS && show_logs_now)
         {
-            printf("   └─ ❌ Default wait time: Invalid value! Expected a number.\n");
+            parser_printf("   └─ ❌ Default wait time: Invalid value! Expected a number.\n");
+        }
+        return 0;
+    }
+    else if (default_wait_time_sec_result == MAX_VALUE_ERROR)
+    {
+        if (SHOW_LOGS && show_logs_now)
+        {
+            parser_printf("   └─ ❌ Default wait time: Value is out of range.\n");
         }
         return 0;
     }
@@ -1488,25 +1802,25 @@ int get_default_wait_time_sec(cJSON *vehicle_p, int *default_wait_time_sec, _Boo
     {
         if (SHOW_LOGS && show_logs_now)
         {
-            printf("   └─ ❌ Default wait time: Value can be only -1 of positive.\n");
+            parser_printf("   └─ ❌ Default wait time: Value can be only -1 of positive.\n");
         }
         return 0;
     }
     if (SHOW_LOGS && show_logs_now)
     {
-        printf("   ├─ ✅ Default wait time: %ds\n", *default_wait_time_sec);
+        parser_printf("   ├─ ✅ Default wait time: %ds\n", *default_wait_time_sec);
     }
     return 1;
 }
 
-int get_default_count(cJSON *vehicle_p, int *default_count, _Bool show_logs_now)
+int get_default_count(const IntField *field, int64_t *default_count, _Bool show_logs_now)
 {
-    StatusType default_wait_time_sec_result = get_int_value(vehicle_p, default_count, "default_count");
+    StatusType default_wait_time_sec_result = get_int64_value(field, default_count);
     if (default_wait_time_sec_result == NOT_FOUND)
     {
         if (SHOW_LOGS && show_logs_now)
         {
-            printf("   └─ ❌ Default count: Field is required!\n");
+            parser_printf("   └─ ❌ Default count: Field is required!\n");
         }
         return 0;
     }
@@ -1514,7 +1828,15 @@ int get_default_count(cJSON *vehicle_p, int *default_count, _Bool show_logs_now)
     {
         if (SHOW_LOGS && show_logs_now)
         {
-            printf("   └─ ❌ Default count: Invalid value! Expected a number.\n");
+            parser_printf("   └─ ❌ Default count: Invalid value! Expected a number.\n");
+        }
+        return 0;
+    }
+    else if (default_wait_time_sec_result == MAX_VALUE_ERROR)
+    {
+        if (SHOW_LOGS && show_logs_now)
+        {
+            parser_printf("   └─ ❌ Default count: Value is out of range.\n");
         }
         return 0;
     }
@@ -1522,7 +1844,7 @@ int get_default_count(cJSON *vehicle_p, int *default_count, _Bool show_logs_now)
     {
         if (SHOW_LOGS && show_logs_now)
         {
-            printf("   └─ ❌ Default count: Must be a positive number.\n");
+            parser_printf("   └─ ❌ Default count: Must be a positive number.\n");
         }
         return 0;
     }
@@ -1530,13 +1852,13 @@ int get_default_count(cJSON *vehicle_p, int *default_count, _Bool show_logs_now)
     {
         if (SHOW_LOGS && show_logs_now)
         {
-            printf("   └─ ❌ Default count: Cannot be zero.\n");
+            parser_printf("   └─ ❌ Default count: Cannot be zero.\n");
         }
         return 0;
     }
     if (SHOW_LOGS && show_logs_now)
     {
-        printf("   ├─ ✅ Default count: %d\n", *default_count);
+        parser_printf("   ├─ ✅ Default count: %" PRId64 "\n", *default_count);
     }
     return 1;
 }
@@ -1547,163 +1869,56 @@ int get_default_count(cJSON *vehicle_p, int *default_count, _Bool show_logs_now)
 
 // ============
 
-StatusType get_custom_waiting_list(cJSON *json, VehicleType vehicle_type, int default_wait_time_sec, int default_fuel_needed, Vehicle **all_user_vehicles, int *count_added_vehicles, _Bool show_logs_now)
+StatusType get_custom_waiting_list_count(const IntField *field, int64_t *count, _Bool show_logs_now)
 {
-    int local_vehicle_capacity = 0;
-    if (vehicle_type == VEHICLE_NOT_FOUND)
-    {
-        return UNKNOWN_ERROR;
-    }
-    cJSON *custom_waiting_list_p = NULL;
-    StatusType custom_waiting_list_result = get_array_value(json, (void **)&custom_waiting_list_p, "custom_waiting_list");
-    if (custom_waiting_list_result == NOT_FOUND)
-    {
-        return NOT_FOUND;
-    }
-    else if (custom_waiting_list_result == WRONG_TYPE)
-    {
-        return WRONG_TYPE;
-    }
-
-    int custom_waiting_list_length = cJSON_GetArraySize(custom_waiting_list_p);
-    if (custom_waiting_list_length == 0)
-    {
-        return EMPTY_VALUE;
-    }
-
-    if (SHOW_LOGS && show_logs_now)
-    {
-        // printf("\n");
-        // printf("✅ [custom_waiting_list] length: %d\n", custom_waiting_list_length);
-    }
-
-    cJSON *custom_waiting_list_item_p = NULL;
-    cJSON_ArrayForEach(custom_waiting_list_item_p, custom_waiting_list_p)
+    StatusType count_result = get_int64_value(field, count);
+    if (count_result == NOT_FOUND)
     {
         if (SHOW_LOGS && show_logs_now)
         {
-            // printf("\n");
-            // printf("--------------------------------Level 2: START\n");
-        }
-
-        int fuel_needed = 0;
-        StatusType fuel_needed_result = get_custom_waiting_list_fuel_needed(custom_waiting_list_item_p, &fuel_needed, false);
-        if (fuel_needed_result == WRONG_TYPE)
-        {
-            continue;
-        }
-        if (fuel_needed_result == WRONG_VALUE)
-        {
-            continue;
-        }
-
-        int wait_time_sec = 0;
-        StatusType wait_time_sec_result = get_custom_waiting_list_wait_time_sec(custom_waiting_list_item_p, &wait_time_sec, false);
-        if (wait_time_sec_result == WRONG_TYPE)
-        {
-            continue;
-        }
-        if (wait_time_sec_result == WRONG_VALUE)
-        {
-            continue;
-        }
-
-        int count = 0;
-        StatusType count_result = get_custom_waiting_list_count(custom_waiting_list_item_p, &count, false);
-        if (count_result != CORRECT_VALUE)
-        {
-            continue;
-        }
-
-        local_vehicle_capacity += count;
-        for (int i = 0; i < count; i++)
-        {
-            Vehicle *new_vehicle = (Vehicle *)malloc(sizeof(Vehicle));
-            if (new_vehicle == NULL)
-            {
-                printf("❌ Memory allocation on new vehicle failed.\n");
-                continue;
-            }
-
-            new_vehicle->vehicle_type = vehicle_type;
-
-            if (fuel_needed_result == NOT_FOUND)
-            {
-                new_vehicle->fuel_needed = default_fuel_needed;
-            }
-            else
-            {
-                new_vehicle->fuel_needed = fuel_needed;
-            }
-
-            if (wait_time_sec_result == NOT_FOUND)
-            {
-                new_vehicle->wait_time_sec = default_wait_time_sec;
-            }
-            else
-            {
-                new_vehicle->wait_time_sec = wait_time_sec;
-            }
-
-            all_user_vehicles[*count_added_vehicles] = new_vehicle;
-            *count_added_vehicles += 1;
-        }
-
-        if (SHOW_LOGS && show_logs_now)
-        {
-            // printf("--------------------------------Level 2: END\n");
+            parser_printf("            ❌ Count: Field is required!\n");
         }
+        return NOT_FOUND;
     }
-
-    if (local_vehicle_capacity == 0)
-    {
-        return WRONG_VALUE;
-    }
-    return CORRECT_VALUE;
-}
-
-StatusType get_custom_waiting_list_count(cJSON *custom_waiting_list_item_p, int *count, _Bool show_logs_now)
-{
-    StatusType count_result = get_int_value(custom_waiting_list_item_p, count, "count");
-    if (count_result == NOT_FOUND)
+    if (count_result == WRONG_TYPE)
     {
         if (SHOW_LOGS && show_logs_now)
         {
-            printf("            ❌ Count: Field is required!\n");
+            parser_printf("            ❌ Count: Invalid value! Expected a number.\n");
         }
-        return NOT_FOUND;
+        return WRONG_TYPE;
     }
-    if (count_result == WRONG_TYPE)
+    if (count_result == MAX_VALUE_ERROR)
     {
         if (SHOW_LOGS && show_logs_now)
         {
-            printf("            ❌ Count: Invalid value! Expected a number.\n");
+            parser_printf("            ❌ Count: Value is out of range.\n");
         }
-        return WRONG_TYPE;
+        return MAX_VALUE_ERROR;
     }
     if ((*count) <= 0)
     {
         if (SHOW_LOGS && show_logs_now)
         {
-            printf("            ❌ Count: Must be greater than 0\n");
+            parser_printf("            ❌ Count: Must be greater than 0\n");
         }
         return WRONG_VALUE;
     }
     if (SHOW_LOGS && show_logs_now)
     {
-        printf("            ✅ Count: %d\n", *count);
+        parser_printf("            ✅ Count: %" PRId64 "\n", *count);
     }
     return CORRECT_VALUE;
 }
 
-StatusType get_custom_waiting_list_fuel_needed(cJSON *custom_waiting_list_item_p, int *fuel_needed, _Bool show_logs_now)
+StatusType get_custom_waiting_list_fuel_needed(const IntField *field, int *fuel_needed, _Bool show_logs_now)
 {
-    StatusType fuel_needed_result = get_int_value(custom_waiting_list_item_p, fuel_needed, "fuel_needed");
+    StatusType fuel_needed_result = get_int_value(field, fuel_needed);
     if (fuel_needed_result == NOT_FOUND)
     {
         if (SHOW_LOGS && show_logs_now)
         {
-            printf("            🔎 Fuel: Not found\n");
+            parser_printf("            🔎 Fuel: Not found\n");
         }
         return NOT_FOUND;
     }
@@ -1711,33 +1926,41 @@ StatusType get_custom_waiting_list_fuel_needed(cJSON *custom_waiting_list_item_p
     {
         if (SHOW_LOGS && show_logs_now)
         {
-            printf("            ❌ Fuel: Invalid value! Expected a number.\n");
+            parser_printf("            ❌ Fuel: Invalid value! Expected a number.\n");
         }
         return WRONG_TYPE;
     }
+    else if (fuel_needed_result == MAX_VALUE_ERROR)
+    {
+        if (SHOW_LOGS && show_logs_now)
+        {
+            parser_printf("            ❌ Fuel: Value is out of range.\n");
+        }
+        return MAX_VALUE_ERROR;
+    }
     else if ((*fuel_needed) <= 0)
     {
         if (SHOW_LOGS && show_logs_now)
         {
-            printf("            ❌ Fuel: Must be greater than 0\n");
+            parser_printf("            ❌ Fuel: Must be greater than 0\n");
         }
         return WRONG_VALUE;
     }
     if (SHOW_LOGS && show_logs_now)
     {
-        printf("            ✅ Fuel: %d\n", *fuel_needed);
+        parser_printf("            ✅ Fuel: %d\n", *fuel_needed);
     }
     return CORRECT_VALUE;
 }
 
-StatusType get_custom_waiting_list_wait_time_sec(cJSON *custom_waiting_list_item_p, int *wait_time_sec, _Bool show_logs_now)
+StatusType get_custom_waiting_list_wait_time_sec(const IntField *field, int *wait_time_sec, _Bool show_logs_now)
 {
-    StatusType wait_time_sec_result = get_int_value(custom_waiting_list_item_p, wait_time_sec, "wait_time_sec");
+    StatusType wait_time_sec_result = get_int_value(field, wait_time_sec);
     if (wait_time_sec_result == NOT_FOUND)
     {
         if (SHOW_LOGS && show_logs_now)
         {
-            printf("            🔎 Wait time: Not found\n");
+            parser_printf("            🔎 Wait time: Not found\n");
         }
         return NOT_FOUND;
     }
@@ -1745,21 +1968,29 @@ StatusType get_custom_waiting_list_wait_time_sec(cJSON *custom_waiting_list_item
     {
         if (SHOW_LOGS && show_logs_now)
         {
-            printf("            ❌ Wait time: Invalid value! Expected a number.\n");
+            parser_printf("            ❌ Wait time: Invalid value! Expected a number.\n");
         }
         return WRONG_TYPE;
     }
+    else if (wait_time_sec_result == MAX_VALUE_ERROR)
+    {
+        if (SHOW_LOGS && show_logs_now)
+        {
+            parser_printf("            ❌ Wait time: Value is out of range.\n");
+        }
+        return MAX_VALUE_ERROR;
+    }
     else if (*wait_time_sec < -1)
     {
         if (SHOW_LOGS && show_logs_now)
         {
-            printf("            ❌ Wait time: Value can be only -1 of positive.\n");
+            parser_printf("            ❌ Wait time: Value can be only -1 of positive.\n");
         }
         return WRONG_VALUE;
     }
     if (SHOW_LOGS && show_logs_now)
     {
-        printf("            ✅ Wait time: %d\n", *wait_time_sec);
+        parser_printf("            ✅ Wait time: %d\n", *wait_time_sec);
     }
     return CORRECT_VALUE;
 }
@@ -1770,72 +2001,109 @@ StatusType get_custom_waiting_list_wait_time_sec(cJSON *custom_waiting_list_item
 
 // ============
 
-void print_json_result(UserJsonResult *json_result)
+const char *get_status_name(StatusType status)
 {
-    printf("\n");
-    printf("🛠️  Simulation Constraints:\n");
-    printf("   🚘 Maximum number of vehicles allowed: %d.\n", MAX_VEHICLES);
-    printf("   ⛽ Maximum fuel pumps allowed: %d.\n", MAX_FUEL_PUMPS_COUNT);
-    printf("   🛢️  Tanker can hold up to %d liters of fuel.\n", MAX_INITIAL_FUEL_IN_TANKER);
-    printf("   🔄 Fuel Transfer Speed: Max %d liters/sec", MAX_FUEL_TRANSFER_RATE);
+    switch (status)
+    {
+    case NOT_FOUND:
+        return "NOT_FOUND";
+    case CORRECT_VALUE:
+        return "CORRECT_VALUE";
+    case WRONG_VALUE:
+        return "WRONG_VALUE";
+    case WRONG_TYPE:
+        return "WRONG_TYPE";
+    case MAX_VEHICLES_ERROR:
+        return "MAX_VEHICLES_ERROR";
+    case EMPTY_VEHICLE_CAPACITY_VALUE:
+        return "EMPTY_VEHICLE_CAPACITY_VALUE";
+    case EMPTY_VALUE:
+        return "EMPTY_VALUE";
+    case VALIDATION_ERROR:
+        return "VALIDATION_ERROR";
+    case MAX_VALUE_ERROR:
+        return "MAX_VALUE_ERROR";
+    case ALLOCATION_ERROR:
+        return "ALLOCATION_ERROR";
+    default:
+        return "UNKNOWN_ERROR";
+    }
+}
 
-    printf("\n");
-    printf("\n");
-    printf("📋 JSON data: \n");
+void print_json_result(UserJsonResult *json_result)
+{
+    parser_printf("\n");
+    parser_printf("🛠️  Simulation Constraints:\n");
+    parser_printf("   🚘 Maximum number of vehicles allowed: %" PRId64 ".\n", scenario_limits.max_vehicles);
+    parser_printf("   ⛽ Maximum fuel pumps allowed: %" PRId64 ".\n", scenario_limits.max_fuel_pumps_count);
+    parser_printf("   🛢️  Tanker can hold up to %" PRId64 " liters of fuel.\n", scenario_limits.max_initial_fuel_in_tanker);
+    parser_printf("   🔄 Fuel Transfer Speed: Max %" PRId64 " liters/sec", scenario_limits.max_fuel_transfer_rate);
+
+    parser_printf("\n");
+    parser_printf("\n");
+    parser_printf("📋 JSON data: \n");
     if (json_result == NULL)
     {
-        printf("   └─ ❌ JSON data is empty.\n");
+        parser_printf("   └─ ❌ JSON data is empty.\n");
         return;
     }
-    printf("   ├─ ✅ Fuel pumps count: %d\n", json_result->fuel_pumps_count);
-    printf("   ├─ ✅ Initial tanker fuel: %d\n", json_result->initial_fuel_in_tanker);
-    printf("   ├─ ✅ Fuel transfer rate: %d\n", json_result->fuel_transfer_rate);
-    printf("   ├─ ✅ Max vehicle capacity: %d\n", json_result->max_vehicle_capacity);
-    printf("   ├─ ✅ Randomized arrival: %s\n", json_result->randomize_arrival == 0 ? "false" : "true");
+    parser_printf("   ├─ ✅ Fuel pumps count: %d\n", json_result->fuel_pumps_count);
+    parser_printf("   ├─ ✅ Initial tanker fuel: %" PRId64 "\n", json_result->initial_fuel_in_tanker);
+    parser_printf("   ├─ ✅ Fuel transfer rate: %" PRId64 "\n", json_result->fuel_transfer_rate);
+    parser_printf("   ├─ ✅ Max vehicle capacity: %" PRId64 "\n", json_result->max_vehicle_capacity);
+    parser_printf("   ├─ ✅ Randomized arrival: %s\n", json_result->randomize_arrival == 0 ? "false" : "true");
 
-    if (json_result->result_vehicles == NULL)
+    if (json_result->vehicle_groups == NULL)
     {
-        printf("   └─ ❌ List of cars is empty.\n");
+        parser_printf("   └─ ❌ List of cars is empty.\n");
         return;
     }
 
-    printf("   └─ ✅ Total vehicles: %d\n", json_result->result_vehicles_length);\
+    parser_printf("   └─ ✅ Total vehicles: %" PRId64 "\n", json_result->result_vehicles_length);
 
-    printf("\n");
-    printf("📋 List of cars:\n");
-    for (int i = 0; i < json_result->result_vehicles_length; i++)
+    VehicleIterator vehicle_iterator;
+    if (vehicle_iterator_init(&vehicle_iterator, json_result) == 0)
     {
-        if (json_result->result_vehicles[i] == NULL)
+        return;
+    }
+    parser_printf("\n");
+    parser_printf("📋 List of cars:\n");
+    Vehicle vehicle;
+    for (int64_t i = 0; vehicle_iterator_next(&vehicle_iterator, &vehicle); i++)
+    {
+        if (i == PRINTED_VEHICLES_LIMIT)
         {
-            printf("❌ json_result->result_vehicles[i] is NULL.\n");
-            continue;
+            parser_printf("   └─ ... %" PRId64 " more vehicles not listed.\n", json_result->result_vehicles_length - i);
+            parser_printf("   \n");
+            break;
         }
-        if (json_result->result_vehicles[i]->vehicle_type == VEHICLE_VAN)
+        if (vehicle.vehicle_type == VEHICLE_VAN)
         {
 
-            printf("   ├─ ✅ #%d(🚙):\n", i + 1);
+            parser_printf("   ├─ ✅ #%" PRId64 "(🚙):\n", i + 1);
         }
-        if (json_result->result_vehicles[i]->vehicle_type == VEHICLE_TRUCK)
+        if (vehicle.vehicle_type == VEHICLE_TRUCK)
         {
 
-            printf("   ├─ ✅ #%d(🚛):\n", i + 1);
+            parser_printf("   ├─ ✅ #%" PRId64 "(🚛):\n", i + 1);
         }
-        if (json_result->result_vehicles[i]->vehicle_type == VEHICLE_AUTO)
+        if (vehicle.vehicle_type == VEHICLE_AUTO)
         {
 
-            printf("   ├─ ✅ #%d(🚗):\n", i + 1);
+            parser_printf("   ├─ ✅ #%" PRId64 "(🚗):\n", i + 1);
         }
         if (i == json_result->result_vehicles_length - 1)
         {
-            printf("   ├   ├─ 🛢️  Fuel: %d liters\n", json_result->result_vehicles[i]->fuel_needed);
-            printf("   ├   └─ ⏳ Wait: %d seconds\n", json_result->result_vehicles[i]->wait_time_sec);    
-            printf("   \n");
+            parser_printf("   ├   ├─ 🛢️  Fuel: %d liters\n", vehicle.fuel_needed);
+            parser_printf("   ├   └─ ⏳ Wait: %d seconds\n", vehicle.wait_time_sec);    
+            parser_printf("   \n");
         }
         else
         {
-            printf("   ├   ├─ 🛢️  Fuel: %d liters\n", json_result->result_vehicles[i]->fuel_needed);
-            printf("   ├   └─ ⏳ Wait: %d seconds\n", json_result->result_vehicles[i]->wait_time_sec);    
-            printf("   ├\n");
+            parser_printf("   ├   ├─ 🛢️  Fuel: %d liters\n", vehicle.fuel_needed);
+            parser_printf("   ├   └─ ⏳ Wait: %d seconds\n", vehicle.wait_time_sec);    
+            parser_printf("   ├\n");
         }
     }
+    vehicle_iterator_close(&vehicle_iterator);
 }
@@ -4,48 +4,85 @@
 #include <stdio.h>
 #include <time.h>
 #include <stdbool.h>
+#include <stdint.h>
 
-#include "cjson/cJSON.h"
+#include "util_vehicle_type.h"
 
-#define MAX_VEHICLES 100
-#define MAX_FUEL_PUMPS_COUNT 10
-#define MAX_INITIAL_FUEL_IN_TANKER 500
-#define MAX_FUEL_TRANSFER_RATE 80
+// Resource ceilings a scenario is checked against unless raised with the `--max-*` options
+#define DEFAULT_MAX_VEHICLES 100
+#define DEFAULT_MAX_FUEL_PUMPS_COUNT 10
+#define DEFAULT_MAX_INITIAL_FUEL_IN_TANKER 500
+#define DEFAULT_MAX_FUEL_TRANSFER_RATE 80
 
-#define my_cJSON_ArrayForEach(element, array, index) for (element = (array != NULL) ? (array)->child : NULL; element != NULL; element = element->next, index++)
+// Feistel rounds of the random vehicle order, and how many slots per vehicle it may visit before
+// the iterator falls back to a Fenwick tree over the groups
+#define VEHICLE_ITERATOR_ROUNDS 4
+#define VEHICLE_ITERATOR_MAX_SLOTS_PER_VEHICLE 4
 
-#define AUTO_ICON "🚗"
-#define VAN_ICON "🚙"
-#define TRUCK_ICON "🚛"
-
-typedef enum
+typedef struct
 {
-    VEHICLE_AUTO,
-    VEHICLE_TRUCK,
-    VEHICLE_VAN,
-    VEHICLE_NOT_FOUND,
-} VehicleType;
+    VehicleType vehicle_type;
+    int wait_time_sec;
+    int fuel_needed;
+} Vehicle;
 
+// [count] identical vehicles, one per default_count or custom_waiting_list item
 typedef struct
 {
     VehicleType vehicle_type;
     int wait_time_sec;
     int fuel_needed;
-} Vehicle;
+    int64_t count;
+} VehicleGroup;
+
+typedef struct
+{
+    int64_t max_vehicles;
+    int64_t max_fuel_pumps_count;
+    int64_t max_initial_fuel_in_tanker;
+    int64_t max_fuel_transfer_rate;
+} ScenarioLimits;
 
 typedef struct
 {
     int fuel_pumps_count;
-    int max_vehicle_capacity;
-    int initial_fuel_in_tanker;
-    int fuel_transfer_rate;
-    int all_vehicles_length;
-    int result_vehicles_length;
+    int64_t max_vehicle_capacity;
+    int64_t initial_fuel_in_tanker;
+    int64_t fuel_transfer_rate;
+    // Sum of all group counts, and how many of them the simulation uses
+    int64_t all_vehicles_length;
+    int64_t result_vehicles_length;
     bool randomize_arrival;
-    Vehicle **all_vehicles;
-    Vehicle **result_vehicles;
+    // Seeds the draw order when [randomize_arrival] is set, so every iteration yields the same cars
+    uint64_t random_seed;
+    int vehicle_groups_length;
+    VehicleGroup *vehicle_groups;
 } UserJsonResult;
 
+// Expands the groups into the [result_vehicles_length] vehicles of the run, one at a time.
+// In file order by default; with [randomize_arrival] every vehicle is drawn from the ones left,
+// which shuffles them and picks a uniform subset when capacity is limited.
+typedef struct
+{
+    const VehicleGroup *groups;
+    int groups_length;
+    int64_t remaining;
+    int group_index;
+    int64_t used_in_group;
+    int64_t remaining_total;
+    uint64_t random_state;
+    // Random draw, allocation free: every group gets [slots_per_group] slots, one per possible vehicle,
+    // and slots are visited in the order of a keyed permutation; empty slots are skipped
+    int64_t slots_per_group;
+    uint64_t slots_count;
+    uint64_t slot_position;
+    int half_bits;
+    uint64_t round_keys[VEHICLE_ITERATOR_ROUNDS];
+    // Random draw when group sizes are too uneven for slots: remaining vehicles per group as a Fenwick tree, indexed from 1
+    int64_t *remaining_counts;
+    int highest_step;
+} VehicleIterator;
+
 typedef enum
 {
     NOT_FOUND,
@@ -61,13 +98,30 @@ typedef enum
     ALLOCATION_ERROR
 } StatusType;
 
+#define READ_DATA_PARSER_ERROR_LENGTH 160
+
 typedef struct
 {
     UserJsonResult *json_result;
     StatusType status;
+    // First error reported while reading, empty if there was none
+    char error[READ_DATA_PARSER_ERROR_LENGTH];
 } ReadDataParserResult;
 
+// Where the parser of the calling thread writes its messages; NULL (the default) is stdout
+void set_read_data_parser_output(FILE *output);
+// Applies to every scenario read afterwards, see DEFAULT_MAX_*
+void set_scenario_limits(const ScenarioLimits *limits);
+const ScenarioLimits *get_scenario_limits();
+// Consumes `--max-vehicles`, `--max-fuel-pumps`, `--max-tanker-fuel` or `--max-transfer-rate` and its value at argv[*index].
+// Returns 1 when the option was applied, 0 when argv[*index] is not a limit option and -1 on a bad value.
+int parse_scenario_limit_argument(int argc, char **argv, int *index);
+const char *get_status_name(StatusType status);
 void print_json_result(UserJsonResult *json_result);
+int vehicle_iterator_init(VehicleIterator *vehicle_iterator, const UserJsonResult *json_result);
+// Returns 0 once all vehicles of the run were produced
+int vehicle_iterator_next(VehicleIterator *vehicle_iterator, Vehicle *vehicle);
+void vehicle_iterator_close(VehicleIterator *vehicle_iterator);
 void clean_up_read_data_parser_result(ReadDataParserResult **read_data_parser_result);
 ReadDataParserResult *read_data_parser(char *path, _Bool show_logs);
 
@@ -0,0 +1,206 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "util_sampler.h"
+#include "util_buffered_writer.h"
+#include "util_json_writer.h"
+#include "utils.h"
+
+static StationSample ring[SAMPLER_RING_CAPACITY];
+static int ring_length = 0;
+
+static SamplesFormat samples_format = SAMPLES_FORMAT_CSV;
+static BufferedWriter *csv_writer = NULL;
+static JsonWriter *json_writer = NULL;
+static int sampling_interval_ms = SAMPLER_DEFAULT_INTERVAL_MS;
+
+static pthread_t sampler_thread;
+static _Bool is_running = false;
+static _Bool is_stopping = false;
+static pthread_mutex_t sampler_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t sampler_cond;
+
+static void write_csv_sample(const StationSample *sample)
+{
+    // 6 numbers of up to 20 characters, separators and newline
+    char line[160];
+    char *cursor = format_uint64(line, sample->timestamp_ns);
+    *cursor++ = ',';
+    cursor = format_int64(cursor, sample->state.fuel_storage);
+    *cursor++ = ',';
+    cursor = format_int64(cursor, sample->state.fuel_left);
+    *cursor++ = ',';
+    cursor = format_int64(cursor, sample->state.occupied_pumps);
+    *cursor++ = ',';
+    cursor = format_int64(cursor, sample->state.cars_waiting_for_pump);
+    *cursor++ = ',';
+    cursor = format_int64(cursor, sample->state.cars_waiting_for_fuel);
+    *cursor++ = '\n';
+    buffered_writer_write(csv_writer, line, cursor - line);
+}
+
+static void write_json_sample(const StationSample *sample)
+{
+    json_writer_begin_object(json_writer, NULL);
+    json_writer_write_int(json_writer, "timestamp_ns", (int64_t)sample->timestamp_ns);
+    json_writer_write_int(json_writer, "fuel_storage", sample->state.fuel_storage);
+    json_writer_write_int(json_writer, "fuel_left", sample->state.fuel_left);
+    json_writer_write_int(json_writer, "occupied_pumps", sample->state.occupied_pumps);
+    json_writer_write_int(json_writer, "cars_waiting_for_pump", sample->state.cars_waiting_for_pump);
+    json_writer_write_int(json_writer, "cars_waiting_for_fuel", sample->state.cars_waiting_for_fuel);
+    json_writer_end_object(json_writer);
+}
+
+static void drain_ring()
+{
+    for (int i = 0; i < ring_length; i++)
+    {
+        if (samples_format == SAMPLES_FORMAT_JSON)
+        {
+            write_json_sample(&ring[i]);
+        }
+        else
+        {
+            write_csv_sample(&ring[i]);
+        }
+    }
+    ring_length = 0;
+}
+
+static void take_sample()
+{
+    if (ring_length == SAMPLER_RING_CAPACITY)
+    {
+        drain_ring();
+    }
+    StationSample *sample = &ring[ring_length++];
+    sample->timestamp_ns = get_elapsed_ns();
+    station_snapshot_read(&sample->state);
+}
+
+static void *sampler(void *thread_data)
+{
+    (void)thread_data;
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+    pthread_mutex_lock(&sampler_lock);
+    while (!is_stopping)
+    {
+        take_sample();
+
+        // Absolute deadlines, so formatting time does not stretch the interval
+        deadline.tv_nsec += (long)(sampling_interval_ms % 1000) * 1000000L;
+        deadline.tv_sec += sampling_interval_ms / 1000 + deadline.tv_nsec / 1000000000L;
+        deadline.tv_nsec %= 1000000000L;
+        while (!is_stopping)
+        {
+            int result = pthread_cond_timedwait(&sampler_cond, &sampler_lock, &deadline);
+            if (result == ETIMEDOUT)
+            {
+                break;
+            }
+        }
+    }
+    take_sample();
+    pthread_mutex_unlock(&sampler_lock);
+    return NULL;
+}
+
+static int open_output(const char *path)
+{
+    if (samples_format == SAMPLES_FORMAT_JSON)
+    {
+        json_writer = json_writer_open(path);
+        if (json_writer == NULL)
+        {
+            return 0;
+        }
+        json_writer_begin_object(json_writer, NULL);
+        json_writer_write_int(json_writer, "interval_ms", sampling_interval_ms);
+        json_writer_begin_array(json_writer, "samples");
+        return 1;
+    }
+
+    csv_writer = buffered_writer_open(path, 0);
+    if (csv_writer == NULL)
+    {
+        return 0;
+    }
+    const char *header = "timestamp_ns,fuel_storage,fuel_left,occupied_pumps,cars_waiting_for_pump,cars_waiting_for_fuel\n";
+    buffered_writer_write(csv_writer, header, strlen(header));
+    return 1;
+}
+
+static int close_output()
+{
+    if (samples_format == SAMPLES_FORMAT_JSON)
+    {
+        json_writer_end_array(json_writer);
+        json_writer_end_object(json_writer);
+        return json_writer_close(&json_writer);
+    }
+    return buffered_writer_close(&csv_writer);
+}
+
+int sampler_start(const char *path, SamplesFormat format, int interval_ms)
+{
+    samples_format = format;
+    sampling_interval_ms = interval_ms > 0 ? interval_ms : SAMPLER_DEFAULT_INTERVAL_MS;
+    ring_length = 0;
+    is_stopping = false;
+
+    if (open_output(path) == 0)
+    {
+        printf("❌ Unable to open samples file '%s'.\n", path);
+        return 0;
+    }
+
+    pthread_condattr_t attributes;
+    pthread_condattr_init(&attributes);
+    pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC);
+    int result = pthread_cond_init(&sampler_cond, &attributes);
+    pthread_condattr_destroy(&attributes);
+    if (result != 0)
+    {
+        printf("❌ Failed to init sampler condition variable.\n");
+        close_output();
+        return 0;
+    }
+
+    if (pthread_create(&sampler_thread, NULL, sampler, NULL) != 0)
+    {
+        printf("❌ Error: pthread_create for sampler\n");
+        pthread_cond_destroy(&sampler_cond);
+        close_output();
+        return 0;
+    }
+    is_running = true;
+    return 1;
+}
+
+void sampler_stop()
+{
+    if (!is_running)
+    {
+        return;
+    }
+    pthread_mutex_lock(&sampler_lock);
+    is_stopping = true;
+    pthread_cond_signal(&sampler_cond);
+    pthread_mutex_unlock(&sampler_lock);
+
+    pthread_join(sampler_thread, NULL);
+    pthread_cond_destroy(&sampler_cond);
+    is_running = false;
+
+    drain_ring();
+    if (close_output() == 0)
+    {
+        printf("❌ Failed to write samples file.\n");
+    }
+}
@@ -0,0 +1,30 @@
+#ifndef UTIL_SAMPLER_H
+#define UTIL_SAMPLER_H
+
+#include <stdint.h>
+
+#include "util_snapshot.h"
+
+// Samples kept in memory before they are formatted and written out
+#define SAMPLER_RING_CAPACITY 1024
+#define SAMPLER_DEFAULT_INTERVAL_MS 100
+
+typedef enum
+{
+    SAMPLES_FORMAT_CSV,
+    SAMPLES_FORMAT_JSON,
+} SamplesFormat;
+
+typedef struct
+{
+    uint64_t timestamp_ns;
+    StationState state;
+} StationSample;
+
+// Time series of the station state (`--samples out.csv`), taken every [interval_ms] of wall time
+// by a background thread that reads the published snapshot and never takes `dynamic_lock`.
+int sampler_start(const char *path, SamplesFormat format, int interval_ms);
+// Takes one last sample and writes everything out
+void sampler_stop();
+
+#endif
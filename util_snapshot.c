@@ -0,0 +1,52 @@
+#include <stdatomic.h>
+
+#include "util_snapshot.h"
+
+// Seqlock: [sequence] is odd while a publish is in progress.
+// Fields are atomics accessed with relaxed ordering, the fences around [sequence] order them.
+static atomic_uint sequence = 0;
+static atomic_int_least64_t fuel_storage = 0;
+static atomic_int_least64_t fuel_left = 0;
+static atomic_int occupied_pumps = 0;
+static atomic_int cars_waiting_for_fuel = 0;
+static atomic_int cars_waiting_for_pump = 0;
+static atomic_int fuel_deliveries = 0;
+
+void station_snapshot_publish(const StationState *state)
+{
+    unsigned int current = atomic_load_explicit(&sequence, memory_order_relaxed);
+    atomic_store_explicit(&sequence, current + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    atomic_store_explicit(&fuel_storage, state->fuel_storage, memory_order_relaxed);
+    atomic_store_explicit(&fuel_left, state->fuel_left, memory_order_relaxed);
+    atomic_store_explicit(&occupied_pumps, state->occupied_pumps, memory_order_relaxed);
+    atomic_store_explicit(&cars_waiting_for_fuel, state->cars_waiting_for_fuel, memory_order_relaxed);
+    atomic_store_explicit(&fuel_deliveries, state->fuel_deliveries, memory_order_relaxed);
+
+    atomic_store_explicit(&sequence, current + 2, memory_order_release);
+}
+
+void station_snapshot_add_waiting_for_pump(int delta)
+{
+    atomic_fetch_add_explicit(&cars_waiting_for_pump, delta, memory_order_relaxed);
+}
+
+void station_snapshot_read(StationState *state)
+{
+    unsigned int before = 0;
+    unsigned int after = 0;
+    do
+    {
+        before = atomic_load_explicit(&sequence, memory_order_acquire);
+        state->fuel_storage = atomic_load_explicit(&fuel_storage, memory_order_relaxed);
+        state->fuel_left = atomic_load_explicit(&fuel_left, memory_order_relaxed);
+        state->occupied_pumps = atomic_load_explicit(&occupied_pumps, memory_order_relaxed);
+        state->cars_waiting_for_fuel = atomic_load_explicit(&cars_waiting_for_fuel, memory_order_relaxed);
+        state->fuel_deliveries = atomic_load_explicit(&fuel_deliveries, memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+        after = atomic_load_explicit(&sequence, memory_order_relaxed);
+    } while ((before & 1) || before != after);
+
+    state->cars_waiting_for_pump = atomic_load_explicit(&cars_waiting_for_pump, memory_order_relaxed);
+}
@@ -0,0 +1,24 @@
+#ifndef UTIL_SNAPSHOT_H
+#define UTIL_SNAPSHOT_H
+
+#include <stdint.h>
+
+// Station state as seen by observers (sampler, exporters) that must not take `dynamic_lock`.
+typedef struct
+{
+    int64_t fuel_storage;
+    int64_t fuel_left;
+    int occupied_pumps;
+    int cars_waiting_for_pump;
+    int cars_waiting_for_fuel;
+    int fuel_deliveries;
+} StationState;
+
+// Writers call this while holding `dynamic_lock`, so there is only one publisher at a time.
+// [cars_waiting_for_pump] is ignored: cars join that queue before taking the lock, see station_snapshot_add_waiting_for_pump.
+void station_snapshot_publish(const StationState *state);
+void station_snapshot_add_waiting_for_pump(int delta);
+// Lock-free; retries while a publish is in progress
+void station_snapshot_read(StationState *state);
+
+#endif
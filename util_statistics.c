@@ -0,0 +1,155 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "util_statistics.h"
+
+void vehicle_statistics_init(VehicleStatistics *statistics)
+{
+    memset(statistics, 0, sizeof(VehicleStatistics));
+    histogram_init(&statistics->wait_time);
+}
+
+void vehicle_statistics_merge(VehicleStatistics *destination, const VehicleStatistics *source)
+{
+    destination->serviced += source->serviced;
+    destination->unserviced += source->unserviced;
+    destination->fuel_required += source->fuel_required;
+    destination->fuel_consumed += source->fuel_consumed;
+    destination->wait_time_ns += source->wait_time_ns;
+    histogram_merge(&destination->wait_time, &source->wait_time);
+}
+
+StatisticsShard *statistics_shards_create(int count)
+{
+    size_t size = (size_t)count * sizeof(StatisticsShard);
+    // aligned_alloc needs the size to be a multiple of the alignment, which sizeof(StatisticsShard) already is
+    StatisticsShard *shards = (StatisticsShard *)aligned_alloc(CACHE_LINE_SIZE, size);
+    if (shards == NULL)
+    {
+        printf("❌ Unable to allocate memory for statistics shards.\n");
+        return NULL;
+    }
+    for (int i = 0; i < count; i++)
+    {
+        atomic_init(&shards[i].sequence, 0);
+        for (int j = 0; j < VEHICLE_NOT_FOUND; j++)
+        {
+            vehicle_statistics_init(&shards[i].per_type[j]);
+        }
+    }
+    return shards;
+}
+
+void statistics_shards_free(StatisticsShard **shards)
+{
+    if ((*shards) == NULL)
+    {
+        return;
+    }
+    free((*shards));
+    (*shards) = NULL;
+}
+
+void statistics_shard_record(StatisticsShard *shard, VehicleType vehicle_type, int fuel_required, _Bool is_serviced, uint64_t wait_time_ns)
+{
+    if (vehicle_type < 0 || vehicle_type >= VEHICLE_NOT_FOUND)
+    {
+        return;
+    }
+
+    unsigned int sequence = atomic_load_explicit(&shard->sequence, memory_order_relaxed);
+    atomic_store_explicit(&shard->sequence, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    VehicleStatistics *statistics = &shard->per_type[vehicle_type];
+    if (is_serviced)
+    {
+        statistics->serviced++;
+        statistics->fuel_consumed += fuel_required;
+    }
+    else
+    {
+        statistics->unserviced++;
+    }
+    statistics->fuel_required += fuel_required;
+    statistics->wait_time_ns += wait_time_ns;
+    histogram_record(&statistics->wait_time, wait_time_ns / 1000);
+
+    atomic_store_explicit(&shard->sequence, sequence + 2, memory_order_release);
+}
+
+void statistics_shards_merge(const StatisticsShard *shards, int count, VehicleStatistics *result)
+{
+    for (int i = 0; i < VEHICLE_NOT_FOUND; i++)
+    {
+        vehicle_statistics_init(&result[i]);
+    }
+
+    // Copy of one shard's counters, too big for a minimal thread stack
+    VehicleStatistics *copy = (VehicleStatistics *)malloc(sizeof(shards[0].per_type));
+    if (copy == NULL)
+    {
+        printf("❌ Unable to allocate memory for statistics snapshot.\n");
+        return;
+    }
+    for (int i = 0; i < count; i++)
+    {
+        unsigned int before = 0;
+        unsigned int after = 0;
+        do
+        {
+            before = atomic_load_explicit(&shards[i].sequence, memory_order_acquire);
+            if (before & 1)
+            {
+                continue;
+            }
+            memcpy(copy, shards[i].per_type, sizeof(shards[i].per_type));
+            atomic_thread_fence(memory_order_acquire);
+            after = atomic_load_explicit(&shards[i].sequence, memory_order_relaxed);
+        } while ((before & 1) || before != after);
+
+        for (int j = 0; j < VEHICLE_NOT_FOUND; j++)
+        {
+            vehicle_statistics_merge(&result[j], &copy[j]);
+        }
+    }
+    free(copy);
+}
+
+void statistics_shards_sum_counts(const StatisticsShard *shards, int count, int64_t *serviced, int64_t *unserviced)
+{
+    for (int j = 0; j < VEHICLE_NOT_FOUND; j++)
+    {
+        serviced[j] = 0;
+        unserviced[j] = 0;
+    }
+    for (int i = 0; i < count; i++)
+    {
+        int64_t shard_serviced[VEHICLE_NOT_FOUND];
+        int64_t shard_unserviced[VEHICLE_NOT_FOUND];
+        unsigned int before = 0;
+        unsigned int after = 0;
+        do
+        {
+            before = atomic_load_explicit(&shards[i].sequence, memory_order_acquire);
+            if (before & 1)
+            {
+                continue;
+            }
+            for (int j = 0; j < VEHICLE_NOT_FOUND; j++)
+            {
+                shard_serviced[j] = shards[i].per_type[j].serviced;
+                shard_unserviced[j] = shards[i].per_type[j].unserviced;
+            }
+            atomic_thread_fence(memory_order_acquire);
+            after = atomic_load_explicit(&shards[i].sequence, memory_order_relaxed);
+        } while ((before & 1) || before != after);
+
+        for (int j = 0; j < VEHICLE_NOT_FOUND; j++)
+        {
+            serviced[j] += shard_serviced[j];
+            unserviced[j] += shard_unserviced[j];
+        }
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef UTIL_STATISTICS_H
+#define UTIL_STATISTICS_H
+
+#include <stdint.h>
+#include <stdatomic.h>
+
+#include "util_read_data_parser.h"
+#include "util_histogram.h"
+
+#define CACHE_LINE_SIZE 64
+
+typedef struct
+{
+    int64_t serviced;
+    int64_t unserviced;
+    int64_t fuel_required;
+    int64_t fuel_consumed;
+    uint64_t wait_time_ns;
+    // Wait times in microseconds
+    Histogram wait_time;
+} VehicleStatistics;
+
+// Statistics of the cars served by one fuel pump, indexed by vehicle type.
+// Only the car holding the pump writes to its shard, so updates are plain stores to a cache line
+// no other core touches. [sequence] is odd while an update is in progress, readers retry on it.
+typedef struct
+{
+    _Alignas(CACHE_LINE_SIZE) atomic_uint sequence;
+    VehicleStatistics per_type[VEHICLE_NOT_FOUND];
+} StatisticsShard;
+
+StatisticsShard *statistics_shards_create(int count);
+void statistics_shards_free(StatisticsShard **shards);
+// Must only be called by the current owner of the shard
+void statistics_shard_record(StatisticsShard *shard, VehicleType vehicle_type, int fuel_required, _Bool is_serviced, uint64_t wait_time_ns);
+// Safe to call while cars are still running; [result] has VEHICLE_NOT_FOUND entries
+void statistics_shards_merge(const StatisticsShard *shards, int count, VehicleStatistics *result);
+// Same, but only the serviced and unserviced counts, without copying the histograms
+void statistics_shards_sum_counts(const StatisticsShard *shards, int count, int64_t *serviced, int64_t *unserviced);
+
+void vehicle_statistics_init(VehicleStatistics *statistics);
+void vehicle_statistics_merge(VehicleStatistics *destination, const VehicleStatistics *source);
+
+#endif
@@ -0,0 +1,65 @@
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "util_trace.h"
+#include "util_buffered_writer.h"
+#include "utils.h"
+
+static BufferedWriter *trace_writer = NULL;
+static pthread_mutex_t trace_lock = PTHREAD_MUTEX_INITIALIZER;
+
+int trace_open(const char *path)
+{
+    trace_writer = buffered_writer_open_async(path, 0);
+    if (trace_writer == NULL)
+    {
+        printf("❌ Unable to open trace file '%s'.\n", path);
+        return 0;
+    }
+
+    TraceHeader header;
+    memset(&header, 0, sizeof(TraceHeader));
+    memcpy(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    header.version = TRACE_VERSION;
+    header.record_size = sizeof(TraceRecord);
+    header.start_time_unix = (int64_t)start_time;
+
+    if (buffered_writer_write(trace_writer, &header, sizeof(TraceHeader)) == 0)
+    {
+        printf("❌ Unable to write trace header.\n");
+        buffered_writer_close(&trace_writer);
+        return 0;
+    }
+    return 1;
+}
+
+void trace_write_event(const SimulationEvent *event)
+{
+    TraceRecord record;
+    record.timestamp_ns = event->timestamp_ns;
+    record.vehicle_id = (uint32_t)event->vehicle_id;
+    record.fuel = event->fuel;
+    record.storage_after = event->storage_after;
+    record.pump_id = (int16_t)event->pump_id;
+    record.kind = (uint8_t)event->kind;
+    record.vehicle_type = (uint8_t)event->vehicle_type;
+
+    pthread_mutex_lock(&trace_lock);
+    if (trace_writer != NULL)
+    {
+        buffered_writer_write(trace_writer, &record, sizeof(TraceRecord));
+    }
+    pthread_mutex_unlock(&trace_lock);
+}
+
+void trace_close()
+{
+    pthread_mutex_lock(&trace_lock);
+    if (trace_writer != NULL && buffered_writer_close(&trace_writer) == 0)
+    {
+        printf("❌ Failed to write trace file.\n");
+    }
+    pthread_mutex_unlock(&trace_lock);
+}
@@ -0,0 +1,39 @@
+#ifndef UTIL_TRACE_H
+#define UTIL_TRACE_H
+
+#include <stdint.h>
+
+#include "util_events.h"
+
+// Binary trace file (`--trace out.gst`):
+// one TraceHeader followed by fixed-width TraceRecord entries in host (little-endian) byte order.
+#define TRACE_MAGIC "GSTRACE"
+#define TRACE_VERSION 2
+
+typedef struct
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    int64_t start_time_unix;
+} TraceHeader;
+
+typedef struct
+{
+    uint64_t timestamp_ns;
+    int64_t fuel;
+    int64_t storage_after;
+    uint32_t vehicle_id;
+    int16_t pump_id;
+    uint8_t kind;
+    uint8_t vehicle_type;
+} TraceRecord;
+
+_Static_assert(sizeof(TraceHeader) == 24, "TraceHeader must stay 24 bytes");
+_Static_assert(sizeof(TraceRecord) == 32, "TraceRecord must stay 32 bytes");
+
+int trace_open(const char *path);
+void trace_write_event(const SimulationEvent *event);
+void trace_close();
+
+#endif
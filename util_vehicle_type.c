@@ -0,0 +1,31 @@
+#include "util_vehicle_type.h"
+
+const char *get_vehicle_icon(VehicleType vehicle_type)
+{
+    if (vehicle_type == VEHICLE_VAN)
+    {
+        return VAN_ICON;
+    }
+    if (vehicle_type == VEHICLE_TRUCK)
+    {
+        return TRUCK_ICON;
+    }
+    return AUTO_ICON;
+}
+
+const char *get_vehicle_type_name(VehicleType vehicle_type)
+{
+    if (vehicle_type == VEHICLE_AUTO)
+    {
+        return "auto";
+    }
+    if (vehicle_type == VEHICLE_VAN)
+    {
+        return "van";
+    }
+    if (vehicle_type == VEHICLE_TRUCK)
+    {
+        return "truck";
+    }
+    return "unknown";
+}
@@ -0,0 +1,19 @@
+#ifndef UTIL_VEHICLE_TYPE_H
+#define UTIL_VEHICLE_TYPE_H
+
+#define AUTO_ICON "🚗"
+#define VAN_ICON "🚙"
+#define TRUCK_ICON "🚛"
+
+typedef enum
+{
+    VEHICLE_AUTO,
+    VEHICLE_TRUCK,
+    VEHICLE_VAN,
+    VEHICLE_NOT_FOUND,
+} VehicleType;
+
+const char *get_vehicle_icon(VehicleType vehicle_type);
+const char *get_vehicle_type_name(VehicleType vehicle_type);
+
+#endif
@@ -10,67 +10,169 @@
 #include <stdarg.h>
 #include <errno.h>
 #include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
 
 #include "util_read_data_parser.h"
+#include "utils.h"
+
+#ifdef DEBUG_
+int log_level = LOG_LEVEL_DEBUG;
+#else
+int log_level = LOG_LEVEL_EVENTS;
+#endif
 
 pthread_mutex_t log_lock = PTHREAD_MUTEX_INITIALIZER;
 time_t start_time = 0;
+uint64_t start_monotonic_ns = 0;
+
+// Timestamp cache: the formatted "HH:MM:SS" (or "HH:MM:SS.mmm") string of the current tick,
+// published with a sequence counter. Readers copy two words and never take a lock;
+// only the first thread that observes a new tick formats it.
+static _Bool timestamp_high_resolution = false;
+static atomic_uint_fast64_t cached_time_sequence = 0;
+static atomic_int_fast64_t cached_time_tick = -1;
+static _Atomic uint64_t cached_time_text[TIMESTAMP_LENGTH / sizeof(uint64_t)];
+static atomic_flag cached_time_refreshing = ATOMIC_FLAG_INIT;
+
+void set_timestamp_high_resolution(_Bool high_resolution)
+{
+    timestamp_high_resolution = high_resolution;
+}
 
-char *get_formatted_time(char *formatted_time)
+static int64_t get_current_time_tick()
 {
-    time_t current_time = time(NULL);
-    time_t diff_time = difftime(current_time, start_time);
+    struct timespec now;
+    // The coarse clock is a plain vDSO read and is precise enough for whole seconds
+    clock_gettime(timestamp_high_resolution ? CLOCK_MONOTONIC : CLOCK_MONOTONIC_COARSE, &now);
+    uint64_t elapsed_ns = (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec - start_monotonic_ns;
+    if ((int64_t)elapsed_ns < 0)
+    {
+        elapsed_ns = 0;
+    }
+    return (int64_t)(elapsed_ns / (timestamp_high_resolution ? 1000000ULL : 1000000000ULL));
+}
 
-    struct tm *utc_time = gmtime(&diff_time);
-    strftime(formatted_time, 10, "%H:%M:%S", utc_time);
+static void put_two_digits(char *destination, int64_t value)
+{
+    destination[0] = (char)('0' + value / 10);
+    destination[1] = (char)('0' + value % 10);
+}
 
-    return formatted_time;
+static void format_time_tick(int64_t tick, char *formatted_time)
+{
+    int64_t milliseconds = 0;
+    if (timestamp_high_resolution)
+    {
+        milliseconds = tick % 1000;
+        tick /= 1000;
+    }
+    put_two_digits(formatted_time, (tick / 3600) % 100);
+    formatted_time[2] = ':';
+    put_two_digits(formatted_time + 3, (tick / 60) % 60);
+    formatted_time[5] = ':';
+    put_two_digits(formatted_time + 6, tick % 60);
+    if (timestamp_high_resolution)
+    {
+        formatted_time[8] = '.';
+        formatted_time[9] = (char)('0' + milliseconds / 100);
+        put_two_digits(formatted_time + 10, milliseconds % 100);
+        formatted_time[12] = '\0';
+    }
+    else
+    {
+        formatted_time[8] = '\0';
+    }
 }
 
-void print_car(VehicleType vehicle_type, int car_number, const char *message, ...)
+char *get_formatted_time(char *formatted_time)
 {
-    va_list args;
-    va_start(args, message);
+    int64_t tick = get_current_time_tick();
+    uint64_t words[TIMESTAMP_LENGTH / sizeof(uint64_t)];
 
-    pthread_mutex_lock(&log_lock);
+    uint64_t sequence = atomic_load_explicit(&cached_time_sequence, memory_order_acquire);
+    if ((sequence & 1) == 0 && atomic_load_explicit(&cached_time_tick, memory_order_relaxed) == tick)
+    {
+        for (size_t i = 0; i < TIMESTAMP_LENGTH / sizeof(uint64_t); i++)
+        {
+            words[i] = atomic_load_explicit(&cached_time_text[i], memory_order_relaxed);
+        }
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&cached_time_sequence, memory_order_relaxed) == sequence)
+        {
+            memcpy(formatted_time, words, TIMESTAMP_LENGTH);
+            return formatted_time;
+        }
+    }
 
-// #ifdef DEBUG_
-    char formatted_time[10];
-    get_formatted_time(formatted_time);
-    if (vehicle_type == VEHICLE_AUTO)
+    // New tick (or a writer is mid-update): format locally and try to publish it
+    memset(words, 0, sizeof(words));
+    format_time_tick(tick, (char *)words);
+    memcpy(formatted_time, words, TIMESTAMP_LENGTH);
+
+    if (!atomic_flag_test_and_set_explicit(&cached_time_refreshing, memory_order_acquire))
+    {
+        sequence = atomic_load_explicit(&cached_time_sequence, memory_order_relaxed);
+        atomic_store_explicit(&cached_time_sequence, sequence + 1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+        atomic_store_explicit(&cached_time_tick, tick, memory_order_relaxed);
+        for (size_t i = 0; i < TIMESTAMP_LENGTH / sizeof(uint64_t); i++)
+        {
+            atomic_store_explicit(&cached_time_text[i], words[i], memory_order_relaxed);
+        }
+        atomic_store_explicit(&cached_time_sequence, sequence + 2, memory_order_release);
+        atomic_flag_clear_explicit(&cached_time_refreshing, memory_order_release);
+    }
+    return formatted_time;
+}
+
+int set_log_level(const char *level_name)
+{
+    if (strcmp(level_name, "off") == 0)
     {
-        printf("[%s] 🚗 #%d: ", formatted_time, car_number);
+        log_level = LOG_LEVEL_OFF;
     }
-    else if (vehicle_type == VEHICLE_VAN)
+    else if (strcmp(level_name, "summary") == 0)
     {
-        printf("[%s] 🚙 #%d: ", formatted_time, car_number);
+        log_level = LOG_LEVEL_SUMMARY;
     }
-    else if (vehicle_type == VEHICLE_TRUCK)
+    else if (strcmp(level_name, "events") == 0)
     {
-        printf("[%s] 🚛 #%d: ", formatted_time, car_number);
+        log_level = LOG_LEVEL_EVENTS;
+    }
+    else if (strcmp(level_name, "debug") == 0)
+    {
+        log_level = LOG_LEVEL_DEBUG;
     }
     else
     {
-        printf("[%s] 🚗 #%d: ", formatted_time, car_number);
+        return 0;
     }
-// #else
-//     if (vehicle_type == VEHICLE_AUTO)
-//     {
-//         printf("🚗 #%d: ", car_number);
-//     }
-//     else if (vehicle_type == VEHICLE_VAN)
-//     {
-//         printf("🚙 #%d: ", car_number);
-//     }
-//     else if (vehicle_type == VEHICLE_TRUCK)
-//     {
-//         printf("🚛 #%d: ", car_number);
-//     }
-//     else
-//     {
-//         printf("🚗 #%d: ", car_number);
-//     }
-// #endif
+    return 1;
+}
+
+uint64_t get_monotonic_ns()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+uint64_t get_elapsed_ns()
+{
+    return get_monotonic_ns() - start_monotonic_ns;
+}
+
+void print_car(VehicleType vehicle_type, int car_number, const char *message, ...)
+{
+    va_list args;
+    va_start(args, message);
+
+    pthread_mutex_lock(&log_lock);
+
+    char formatted_time[TIMESTAMP_LENGTH];
+    get_formatted_time(formatted_time);
+    printf("[%s] %s #%d: ", formatted_time, get_vehicle_icon(vehicle_type), car_number);
     vprintf(message, args);
     printf("\n");
 
@@ -86,13 +188,9 @@ void print_tanker(int car_number, const char *message, ...)
 
     pthread_mutex_lock(&log_lock);
 
-// #ifdef DEBUG_
-    char formatted_time[10];
+    char formatted_time[TIMESTAMP_LENGTH];
     get_formatted_time(formatted_time);
     printf("[%s] 🚚 #%d: ", formatted_time, car_number);
-// #else
-//     printf("🚚 #%d: ", car_number);
-// #endif
     vprintf(message, args);
     printf("\n");
 
@@ -106,7 +204,7 @@ void print_debug(const char *message, ...)
     va_list args;
     va_start(args, message);
 
-    char formatted_time[10];
+    char formatted_time[TIMESTAMP_LENGTH];
     get_formatted_time(formatted_time);
 
     pthread_mutex_lock(&log_lock);
@@ -5,12 +5,78 @@
 #include <pthread.h>
 #include <time.h>
 #include <stdarg.h>
+#include <stdint.h>
+#include <stdbool.h>
 
-pthread_mutex_t log_lock;
-time_t start_time;
+#include "util_read_data_parser.h"
+
+#define LOG_LEVEL_OFF 0
+#define LOG_LEVEL_SUMMARY 1
+#define LOG_LEVEL_EVENTS 2
+#define LOG_LEVEL_DEBUG 3
+
+// Most verbose level compiled into the binary (-DLOG_LEVEL_FLOOR=1 keeps only the statistics block).
+// Call sites above the floor are constant-false and are removed together with their arguments.
+#ifndef LOG_LEVEL_FLOOR
+#define LOG_LEVEL_FLOOR LOG_LEVEL_DEBUG
+#endif
+
+#define LOG_ENABLED(level) (LOG_LEVEL_FLOOR >= (level) && log_level >= (level))
+
+#define LOG_PRINTF(level, ...)             \
+    do                                     \
+    {                                      \
+        if (LOG_ENABLED(level))            \
+        {                                  \
+            printf(__VA_ARGS__);           \
+        }                                  \
+    } while (0)
+
+#define LOG_CAR(...)                       \
+    do                                     \
+    {                                      \
+        if (LOG_ENABLED(LOG_LEVEL_EVENTS)) \
+        {                                  \
+            print_car(__VA_ARGS__);        \
+        }                                  \
+    } while (0)
+
+#define LOG_TANKER(...)                    \
+    do                                     \
+    {                                      \
+        if (LOG_ENABLED(LOG_LEVEL_EVENTS)) \
+        {                                  \
+            print_tanker(__VA_ARGS__);     \
+        }                                  \
+    } while (0)
+
+#define LOG_DEBUG(...)                     \
+    do                                     \
+    {                                      \
+        if (LOG_ENABLED(LOG_LEVEL_DEBUG))  \
+        {                                  \
+            print_debug(__VA_ARGS__);      \
+        }                                  \
+    } while (0)
+
+// Room for "HH:MM:SS.mmm" plus '\0', rounded up to whole 8-byte words
+#define TIMESTAMP_LENGTH 16
+
+extern int log_level;
+extern pthread_mutex_t log_lock;
+extern time_t start_time;
+extern uint64_t start_monotonic_ns;
+
+int set_log_level(const char *level_name);
+
+void set_timestamp_high_resolution(_Bool high_resolution);
 
 char *get_formatted_time(char *formatted_time);
 
+uint64_t get_monotonic_ns();
+
+uint64_t get_elapsed_ns();
+
 void print_car(VehicleType vehicle_type, int car_number, const char *message, ...);
 
 void print_tanker(int car_number, const char *message, ...);
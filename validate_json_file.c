@@ -7,39 +7,25 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <dirent.h>
+#include <sys/stat.h>
 
 #include "util_read_data_parser.h"
+#include "util_compiled_scenario.h"
+#include "util_batch_validation.h"
 
 static ReadDataParserResult *read_data_parser_result = NULL;
 static char *default_json_file = "data.json";
 static char *path = NULL;
 
+// Any path that can be opened as a scenario: regular files, but also pipes like /dev/stdin
 int check_if_file_exist(char *name)
 {
-    DIR *dir_stream = opendir(".");
-    if (dir_stream == NULL)
+    struct stat file_stat;
+    if (stat(name, &file_stat) != 0)
     {
-        perror("❌ Cannot open reading dir stream.\n");
-        return -1;
+        return 0;
     }
-    int found_flag = 0;
-    struct dirent *dp = readdir(dir_stream);
-    while (dp != NULL)
-    {
-        if (strncmp(dp->d_name, name, strlen(name)) == 0)
-        {
-            found_flag = 1;
-            break;
-        }
-        dp = readdir(dir_stream);
-    }
-    if (closedir(dir_stream) != 0)
-    {
-        perror("❌ Cannot close reading dir stream.\n");
-        return -1;
-    }
-    return found_flag;
+    return !S_ISDIR(file_stat.st_mode);
 }
 
 int get_result_path(int argc, char **argv)
@@ -49,12 +35,7 @@ int get_result_path(int argc, char **argv)
     if (argc == 1)
     {
         printf("🔍 Path was not specified, trying to read '%s'...\n", default_json_file);
-        int if_file_exist_result = check_if_file_exist(default_json_file);
-        if (if_file_exist_result == -1)
-        {
-            return 0;
-        }
-        if (if_file_exist_result == 0)
+        if (check_if_file_exist(default_json_file) == 0)
         {
             printf("❌ File '%s' was NOT found.\n", default_json_file);
             return 0;
@@ -70,22 +51,13 @@ int get_result_path(int argc, char **argv)
     {
         char *user_path = argv[1];
         const int user_path_length = strlen(user_path);
-        char user_path_result[user_path_length + 1];
-
-        strncpy(user_path_result, user_path, user_path_length + 1);
-        user_path_result[user_path_length] = '\0';
 
-        int if_file_exist_result = check_if_file_exist(user_path_result);
-        if (if_file_exist_result == -1)
-        {
-            return 0;
-        }
-        if (if_file_exist_result == 0)
+        if (check_if_file_exist(user_path) == 0)
         {
-            printf("❌ File '%s' was NOT found.\n", user_path_result);
+            printf("❌ File '%s' was NOT found.\n", user_path);
             return 0;
         }
-        printf("✅ File '%s' was found.\n", user_path_result);
+        printf("✅ File '%s' was found.\n", user_path);
         printf("\n");
         printf("✅ Parsing...\n");
         printf("\n");
@@ -95,7 +67,8 @@ int get_result_path(int argc, char **argv)
             printf("❌ ALLOCATION_ERROR\n");
             return 0;
         }
-        strncpy((path), user_path_result, user_path_length + 1);
+        (path) = temp;
+        strncpy((path), user_path, user_path_length + 1);
         (path)[user_path_length] = '\0';
     }
     return 1;
@@ -115,8 +88,89 @@ void clean_up_validation()
     }
 }
 
+// `validation --batch [--jobs <n>] [--results <file.json>] <file|glob|directory>...`
+int run_batch_validation(int argc, char **argv)
+{
+    int jobs = 0;
+    char *results_path = NULL;
+    BatchValidation *batch = batch_validation_create();
+    if (batch == NULL)
+    {
+        return 1;
+    }
+    for (int i = 1; i < argc; i++)
+    {
+        int limit_result = parse_scenario_limit_argument(argc, argv, &i);
+        if (limit_result == -1)
+        {
+            batch_validation_free(&batch);
+            return 1;
+        }
+        if (limit_result == 1 || strcmp(argv[i], "--batch") == 0)
+        {
+            continue;
+        }
+        if (strcmp(argv[i], "--jobs") == 0)
+        {
+            if (i + 1 >= argc || (jobs = atoi(argv[i + 1])) <= 0)
+            {
+                printf("❌ [--jobs]: Expected a positive number of threads.\n");
+                batch_validation_free(&batch);
+                return 1;
+            }
+            i++;
+        }
+        else if (strcmp(argv[i], "--results") == 0)
+        {
+            if (i + 1 >= argc)
+            {
+                printf("❌ [--results]: Missing output file path.\n");
+                batch_validation_free(&batch);
+                return 1;
+            }
+            results_path = argv[++i];
+        }
+        else if (batch_validation_add_input(batch, argv[i]) == 0)
+        {
+            batch_validation_free(&batch);
+            return 1;
+        }
+    }
+    if (batch->files_count == 0)
+    {
+        printf("❌ [--batch]: No scenario files to validate.\n");
+        batch_validation_free(&batch);
+        return 1;
+    }
+
+    int result = batch_validation_run(batch, jobs);
+    if (result)
+    {
+        // With `--results -` stdout only gets the machine-readable results
+        if (results_path == NULL || strcmp(results_path, "-") != 0)
+        {
+            batch_validation_print(batch);
+        }
+        if (results_path != NULL)
+        {
+            result = batch_validation_write_json(batch, results_path);
+        }
+        result = result && batch->valid_count == batch->files_count;
+    }
+    batch_validation_free(&batch);
+    return result ? 0 : 1;
+}
+
 int main(int argc, char **argv)
 {
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--batch") == 0)
+        {
+            return run_batch_validation(argc, argv);
+        }
+    }
+
     atexit(clean_up_validation);
     const int default_json_file_length = strlen(default_json_file);
     path = (char *)malloc((default_json_file_length + 1) * sizeof(char));
@@ -126,7 +180,37 @@ int main(int argc, char **argv)
         return 1;
     }
 
-    if (get_result_path(argc, argv) == 0)
+    // `--compile <file>` and the `--max-*` limits may come before or after the scenario path
+    char *compile_path = NULL;
+    char *arguments[2] = {argv[0], NULL};
+    int arguments_count = 1;
+    for (int i = 1; i < argc; i++)
+    {
+        int limit_result = parse_scenario_limit_argument(argc, argv, &i);
+        if (limit_result == -1)
+        {
+            return 1;
+        }
+        if (limit_result == 1)
+        {
+            continue;
+        }
+        if (strcmp(argv[i], "--compile") == 0)
+        {
+            if (i + 1 >= argc)
+            {
+                printf("❌ [--compile]: Missing output file path.\n");
+                return 1;
+            }
+            compile_path = argv[++i];
+        }
+        else if (arguments_count < 2)
+        {
+            arguments[arguments_count++] = argv[i];
+        }
+    }
+
+    if (get_result_path(arguments_count, arguments) == 0)
     {
         return 1;
     }
@@ -200,5 +284,16 @@ int main(int argc, char **argv)
     printf("\n");
     printf("✅ Successfully parsed 'data.json' file.\n");
     print_json_result(read_data_parser_result->json_result);
+
+    if (compile_path != NULL)
+    {
+        if (compiled_scenario_write(compile_path, read_data_parser_result->json_result) == 0)
+        {
+            return 1;
+        }
+        printf("\n");
+        printf("✅ Compiled scenario saved to '%s' (%d vehicle groups). Run it with: gas_station --scenario %s\n",
+               compile_path, read_data_parser_result->json_result->vehicle_groups_length, compile_path);
+    }
     return 0;
 }